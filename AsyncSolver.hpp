@@ -0,0 +1,374 @@
+#ifndef _ASYNC_SOLVER_HPP_
+#define _ASYNC_SOLVER_HPP_
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <exception>
+#include <future>
+#include <limits>
+#include <memory>
+#include <vector>
+#include "Logger.hpp"
+#include "SolveStats.hpp"
+#include "SolverTraits.hpp"
+#include "ThreadPool.hpp"
+
+/* * * * * * * * * * * * * * * * * * * * * *
+ * Base class of the asynchronous solvers  *
+ * * * * * * * * * * * * * * * * * * * * * */
+/*!
+ * For a function that returns a future of its value (AsyncFunType), e.g. a
+ * request to a remote service. The solve is a state machine: start issues
+ * the first evaluations, every poll checks, without blocking, whether the
+ * pending ones are ready and, when all of them are, passes their values to
+ * advance, which issues the next ones or ends the solve. Many solves can
+ * then be interleaved on a single thread (AsyncSolveLoop), and a method can
+ * request several points at once (AsyncMultisection).
+ * An evaluation that throws ends the solve with status EvaluationFailed.
+ */
+template<class Traits>
+class BasicAsyncSolver
+{
+public:
+	using Real = typename Traits::Real;
+	using AsyncFunType = typename Traits::AsyncFunType;
+
+	explicit BasicAsyncSolver(const AsyncFunType& f_) : f(f_) {}
+
+	BasicAsyncSolver(const BasicAsyncSolver&) = delete;
+	BasicAsyncSolver& operator=(const BasicAsyncSolver&) = delete;
+
+	virtual ~BasicAsyncSolver() = default;
+
+	// Issues the first evaluations
+	void start()
+	{
+		stats = BasicSolveStats<Traits>();
+		finished = false;
+		pending.clear();
+		points.clear();
+		startTime = std::chrono::steady_clock::now();
+		begin();
+	}
+
+	// Advances the solve if the pending evaluations are ready, never blocks
+	/*!
+	 * @return true if the solve is over
+	 */
+	bool poll();
+
+	// All the pending evaluations are ready, poll will go on
+	bool ready() const
+	{
+		return std::all_of(pending.begin(), pending.end(), [](const std::future<Real>& p) {return p.wait_for(std::chrono::seconds(0)) == std::future_status::ready;});
+	}
+
+	// Waits until the first pending evaluation is ready, at most for timeout
+	template<class Rep, class Period>
+	void wait(const std::chrono::duration<Rep, Period>& timeout) const
+	{
+		for (const std::future<Real>& p : pending)
+			if (p.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+			{
+				p.wait_for(timeout);
+				return;
+			}
+	}
+
+	// Runs the solve to the end on the calling thread
+	BasicSolveStats<Traits> solve()
+	{
+		start();
+		while (!poll())
+			wait(std::chrono::milliseconds(1));
+		return stats;
+	}
+
+	// The solve is over
+	bool done() const {return finished;}
+
+	// Statistics of the last solve, complete when done
+	const BasicSolveStats<Traits>& result() const {return stats;}
+
+protected:
+	// Function
+	AsyncFunType f;
+	// Statistics of the solve
+	BasicSolveStats<Traits> stats;
+
+	// Requests f at x
+	void request(const Real& x)
+	{
+		++stats.fEvals;
+		points.push_back(x);
+		pending.push_back(f(x));
+	}
+
+	// Issues the first requests
+	virtual void begin() = 0;
+
+	// Called with the values of all the requests of the last round: issues
+	// the next ones, or calls finish
+	virtual void advance(const std::vector<Real>& x, const std::vector<Real>& y) = 0;
+
+	// Ends the solve
+	void finish(const SolveStatus& status, const Real& zero, const unsigned int& iterations, const Real& residual, const Real& bracketWidth = std::numeric_limits<Real>::quiet_NaN())
+	{
+		stats.zero = zero;
+		stats.status = status;
+		stats.iterations = iterations;
+		stats.residual = residual;
+		stats.bracketWidth = bracketWidth;
+		stats.wallTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+		finished = true;
+	}
+
+private:
+	// Evaluations of the current round
+	std::vector<std::future<Real>> pending;
+	std::vector<Real> points;
+	bool finished{false};
+	std::chrono::steady_clock::time_point startTime;
+};
+
+template<class Traits>
+bool BasicAsyncSolver<Traits>::poll()
+{
+	if (finished)
+		return true;
+	if (!ready())
+		return false;
+
+	std::vector<Real> x;
+	x.swap(points);
+	std::vector<Real> y(x.size());
+	std::vector<std::future<Real>> values;
+	values.swap(pending);
+	try
+	{
+		for (std::size_t i = 0; i < values.size(); ++i)
+			y[i] = values[i].get();
+	}
+	catch (const std::exception& e)
+	{
+		Logger::log(LogLevel::Error, "ERROR, evaluation of f failed: ", e.what());
+		finish(SolveStatus::EvaluationFailed, std::numeric_limits<Real>::quiet_NaN(), stats.iterations, std::numeric_limits<Real>::quiet_NaN());
+		return true;
+	}
+	advance(x, y);
+	return finished;
+}
+
+/* * * * * * * * * * * * * * * * * * * * *
+ * Asynchronous multisection (Bisection)  *
+ * * * * * * * * * * * * * * * * * * * * */
+/*!
+ * At every round the k - 1 points dividing [a, b] in k equal parts are
+ * requested together and the subinterval where f changes sign is kept: one
+ * round gains log2(k) bits in the latency of one evaluation, k = 2 is the
+ * bisection method. f must change sign at a and b, no interval is searched.
+ * Converged when the interval is narrower than 2 tol, or at an exact zero.
+ */
+template<class Traits>
+class BasicAsyncMultisection final : public BasicAsyncSolver<Traits>
+{
+public:
+	using typename BasicAsyncSolver<Traits>::Real;
+	using typename BasicAsyncSolver<Traits>::AsyncFunType;
+
+	BasicAsyncMultisection(const AsyncFunType& f_, const Real& a_, const Real& b_, const Real& tol_, const unsigned int& k_ = 4, const unsigned int& maxIt_ = 150) :
+		BasicAsyncSolver<Traits>(f_), a0(a_), b0(b_), tol(tol_), k(std::max(2u, k_)), maxIt(maxIt_) {}
+
+protected:
+	void begin() override
+	{
+		a = a0;
+		b = b0;
+		iter = 0u;
+		initial = true;
+		this->request(a);
+		this->request(b);
+	}
+
+	void advance(const std::vector<Real>& x, const std::vector<Real>& y) override;
+
+private:
+	// Initial interval
+	Real a0;
+	Real b0;
+	Real tol;
+	// Number of subintervals of a round
+	unsigned int k;
+	unsigned int maxIt;
+	// Current interval
+	Real a;
+	Real b;
+	Real fa;
+	Real fb;
+	unsigned int iter{0u};
+	// The last round evaluated the extremes
+	bool initial{true};
+
+	// Requests the points of the next round
+	void divide()
+	{
+		const Real h = (b - a) / k;
+		for (unsigned int i = 1; i < k; ++i)
+			this->request(a + i * h);
+	}
+};
+
+template<class Traits>
+void BasicAsyncMultisection<Traits>::advance(const std::vector<Real>& x, const std::vector<Real>& y)
+{
+	if (initial)
+	{
+		initial = false;
+		fa = y[0];
+		fb = y[1];
+		if (!(fa * fb <= 0))
+		{
+			Logger::log(LogLevel::Error, "ERROR, function must change sign at the two end values");
+			this->finish(SolveStatus::InvalidInterval, std::numeric_limits<Real>::quiet_NaN(), 0u, std::min(std::abs(fa), std::abs(fb)), b - a);
+			return;
+		}
+		if (fa == 0. || fb == 0.)
+		{
+			this->finish(SolveStatus::Converged, fa == 0. ? a : b, 0u, 0., b - a);
+			return;
+		}
+	}
+	else
+	{
+		++iter;
+		// First subinterval with a sign change, the points are increasing
+		Real xl = a;
+		Real yl = fa;
+		for (std::size_t i = 0; i <= x.size(); ++i)
+		{
+			const Real xr = (i < x.size()) ? x[i] : b;
+			const Real yr = (i < x.size()) ? y[i] : fb;
+			if (yr == 0.)
+			{
+				this->finish(SolveStatus::Converged, xr, iter, 0., xr - xl);
+				return;
+			}
+			if (yl * yr < 0)
+			{
+				a = xl;
+				fa = yl;
+				b = xr;
+				fb = yr;
+				break;
+			}
+			xl = xr;
+			yl = yr;
+		}
+	}
+
+	if (b - a <= 2 * tol)
+		this->finish(SolveStatus::Converged, (a + b) / 2, iter, std::min(std::abs(fa), std::abs(fb)), b - a);
+	else if (iter >= maxIt)
+		this->finish(SolveStatus::MaxIterations, (a + b) / 2, iter, std::min(std::abs(fa), std::abs(fb)), b - a);
+	else
+		divide();
+}
+
+/* * * * * * * * * * * * * * * * * * * * *
+ * Event loop of asynchronous solves      *
+ * * * * * * * * * * * * * * * * * * * * */
+/*!
+ * Runs many asynchronous solves on the calling thread: at most maxActive
+ * are started at once (0 = all), the others as soon as one ends, so that
+ * the requests in flight are bounded. The loop polls the active solves and
+ * sleeps on a pending evaluation when none of them can go on.
+ */
+template<class Traits>
+class BasicAsyncSolveLoop
+{
+public:
+	using Solver = std::unique_ptr<BasicAsyncSolver<Traits>>;
+
+	explicit BasicAsyncSolveLoop(std::size_t maxActive_ = 0u) : maxActive(maxActive_) {}
+
+	// Adds a solve, returns its index in the results
+	std::size_t add(Solver solver)
+	{
+		solvers.push_back(std::move(solver));
+		return solvers.size() - 1;
+	}
+
+	// Runs all the solves added, the statistics are in the order of add
+	std::vector<BasicSolveStats<Traits>> run();
+
+	// Solver of a solve
+	BasicAsyncSolver<Traits>& solver(std::size_t i) {return *solvers[i];}
+
+private:
+	std::vector<Solver> solvers;
+	std::size_t maxActive;
+};
+
+template<class Traits>
+std::vector<BasicSolveStats<Traits>> BasicAsyncSolveLoop<Traits>::run()
+{
+	const std::size_t limit = (maxActive == 0u) ? solvers.size() : maxActive;
+	std::vector<std::size_t> active;
+	std::size_t next{0u};
+	while (next < solvers.size() || !active.empty())
+	{
+		while (next < solvers.size() && active.size() < limit)
+		{
+			solvers[next]->start();
+			active.push_back(next++);
+		}
+
+		// Polls all the active solves, the finished ones are removed
+		active.erase(std::remove_if(active.begin(), active.end(), [this](std::size_t i) {return solvers[i]->poll();}), active.end());
+		if (!active.empty() && std::none_of(active.begin(), active.end(), [this](std::size_t i) {return solvers[i]->ready();}))
+			solvers[active.front()]->wait(std::chrono::microseconds(200));
+	}
+
+	std::vector<BasicSolveStats<Traits>> results;
+	results.reserve(solvers.size());
+	for (const Solver& s : solvers)
+		results.push_back(s->result());
+	return results;
+}
+
+// Asynchronous version of a synchronous function, evaluated on the pool
+/*!
+ * For an f that is costly to compute locally: the evaluations requested
+ * together by a round run in parallel on the workers of the pool
+ */
+template<class Traits, class F>
+typename Traits::AsyncFunType makeAsync(const F& f, ThreadPool& pool = ThreadPool::shared())
+{
+	using Real = typename Traits::Real;
+	ThreadPool* p = &pool;
+	return [f, p](const Real& x)
+	{
+		auto promise = std::make_shared<std::promise<Real>>();
+		std::future<Real> value = promise->get_future();
+		p->submit([f, x, promise]()
+		{
+			try
+			{
+				promise->set_value(f(x));
+			}
+			catch (...)
+			{
+				promise->set_exception(std::current_exception());
+			}
+		});
+		return value;
+	};
+}
+
+using AsyncSolver = BasicAsyncSolver<SolverTraits>;
+using AsyncMultisection = BasicAsyncMultisection<SolverTraits>;
+using AsyncSolveLoop = BasicAsyncSolveLoop<SolverTraits>;
+
+#endif
@@ -0,0 +1,377 @@
+#ifndef _AUTO_SOLVER_HPP_
+#define _AUTO_SOLVER_HPP_
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "classZeroFun.hpp"
+#include "SolverFactory.hpp"
+
+/* * * * * * * * * * * * * * * * * * * * * *
+ * History of the methods chosen by Auto   *
+ * * * * * * * * * * * * * * * * * * * * * */
+/*!
+ * Outcomes and costs of the solves of every method, shared by the Auto
+ * solvers of a batch (the solvers of different functions should use
+ * different histories). Thread safe.
+ */
+class AutoHistory
+{
+public:
+	struct Record
+	{
+		// Solves with the method
+		std::size_t solves{0u};
+		// Solves that did not converge
+		std::size_t failures{0u};
+		// Total estimated cost of the solves, in seconds
+		double cost{0.};
+
+		double meanCost() const {return solves > 0 ? cost / solves : std::numeric_limits<double>::infinity();}
+	};
+
+	// Adds the outcome of a solve
+	void add(const std::string& method, bool ok, double cost)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		Record& r = records[method];
+		++r.solves;
+		r.failures += ok ? 0u : 1u;
+		r.cost += cost;
+	}
+
+	// Record of a method, empty if it was never used
+	Record get(const std::string& method) const
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		const auto it = records.find(method);
+		return (it == records.end()) ? Record() : it->second;
+	}
+
+	// Counts a new solve, returns the number of solves so far
+	std::size_t next()
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		return ++count;
+	}
+
+	// Forgets everything
+	void clear()
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		records.clear();
+		count = 0u;
+	}
+
+	// History used by default
+	static AutoHistory& shared()
+	{
+		static AutoHistory history;
+		return history;
+	}
+
+private:
+	mutable std::mutex mutex;
+	std::unordered_map<std::string, Record> records;
+	std::size_t count{0u};
+};
+
+/* * * * * * * * * * * * * * * * * * * * * *
+ * Stall of an open method                 *
+ * * * * * * * * * * * * * * * * * * * * * */
+/*!
+ * Checked at every iteration of Newton and Secant without a bracket. An
+ * iteration makes no progress if |f(x)| is not below 0.9 times the
+ * smallest residual so far; after patience iterations in a row without
+ * progress in which the steps shrink (stagnation) or change sign
+ * (oscillation) the method is stalled.
+ */
+template<class Real>
+struct BasicStallWatch
+{
+	// Iterations in a row without progress before a stall
+	static constexpr unsigned int patience = 4u;
+
+	// Starts a new solve
+	void clear()
+	{
+		best = std::numeric_limits<Real>::infinity();
+		lastDx = 0.;
+		shrinking = 0u;
+		flipping = 0u;
+		stalled = false;
+	}
+
+	// True if the method is stalled after the step dx, with f(x) = fx
+	bool operator()(const Real& dx, const Real& fx)
+	{
+		const Real r = std::abs(fx);
+		if (r < 0.9 * best)
+		{
+			best = r;
+			shrinking = 0u;
+			flipping = 0u;
+		}
+		else
+		{
+			shrinking = (std::abs(dx) <= std::abs(lastDx)) ? shrinking + 1u : 0u;
+			flipping = (dx * lastDx < 0) ? flipping + 1u : 0u;
+		}
+		lastDx = dx;
+		stalled = (shrinking >= patience || flipping >= patience);
+		return stalled;
+	}
+
+	// Smallest residual so far
+	Real best{std::numeric_limits<Real>::infinity()};
+	Real lastDx{0.};
+	// Iterations in a row without progress with shrinking steps, with steps of alternate sign
+	unsigned int shrinking{0u};
+	unsigned int flipping{0u};
+	bool stalled{false};
+};
+
+/* * * * * * * * * * * * * * * * * * * * * *
+ * Automatic choice of the method (Auto)   *
+ * * * * * * * * * * * * * * * * * * * * * */
+/*!
+ * Probes the problem first: the sign of f at the extremes, whether a
+ * derivative is given (df, or fd through automatic differentiation) and
+ * the cost of f and df, timed on one evaluation. The candidates are
+ *  - with a bracket: SafeNewton (with a derivative), Brent, Secant;
+ *  - without one: Newton (with a derivative) and Secant from x0;
+ * and the first one is taken, unless the history shows that another one
+ * has converged on at least 90% of its past solves for less cost (fEvals
+ * and dfEvals weighted by the timed costs). Every explorePeriod solves a
+ * candidate with too few records is tried instead, so that the history
+ * covers them all.
+ * The methods without a bracket run with at most openBudget iterations;
+ * they, and Secant also when it is a candidate on a bracket, have a
+ * BasicStallWatch added to the stopping policy: if they stall (status
+ * Stalled) or do not converge the solve switches to Brent, which searches
+ * a bracket from [a, b]. The iterations, the evaluations and the deadline
+ * of the stopping policy are for the whole solve: every attempt gets what
+ * the probes and the previous attempts left. The statistics add the probes
+ * and all the attempts.
+ */
+template<class Traits>
+class BasicAutoSolver final : public BasicSolverBase<Traits>
+{
+public:
+	using typename BasicSolverBase<Traits>::Real;
+	using Functions = BasicSolverFunctions<Traits>;
+	using typename BasicSolverBase<Traits>::Parameters;
+	using typename BasicSolverBase<Traits>::Problem;
+
+	// Records needed before a method is chosen for its history
+	static constexpr std::size_t minSolves = 8u;
+	// Period of the solves that try a method with few records
+	static constexpr std::size_t explorePeriod = 16u;
+	// Iterations allowed to Newton and Secant without a bracket
+	static constexpr unsigned int openBudget = 30u;
+
+	// Constructor, the history is shared by all the Auto solvers by default
+	BasicAutoSolver(const Functions& fs_, const Parameters& p_, AutoHistory& history_ = AutoHistory::shared()) :
+		BasicSolverBase<Traits>(fs_.f, p_.tol), fs(fs_), params(p_), history(&history_)
+	{
+		if (!fs.df && fs.fd)
+			fs.df = DualDerivative<Traits, typename Traits::DualFunType>{fs.fd};
+	}
+
+	Real solve() override;
+	using BasicSolverBase<Traits>::solve;
+
+	// Changes all the parameters
+	void reset(const Parameters& p_) override
+	{
+		params = p_;
+		BasicSolverBase<Traits>::reset(p_);
+	}
+
+	// Changes the interval and the starting point
+	void setProblem(const Problem& problem) override
+	{
+		params.a = problem.a;
+		params.b = problem.b;
+		params.x0 = problem.x0;
+	}
+
+	// Method that gave the result of the last solve
+	const std::string& method() const {return chosen;}
+
+private:
+	Functions fs;
+	Parameters params;
+	AutoHistory* history;
+	// Solvers of the methods tried so far, reset for every solve
+	std::unordered_map<std::string, std::unique_ptr<BasicSolverBase<Traits>>> solvers;
+	// Timed costs of f and df, negative until measured
+	double fCost{-1.};
+	double dfCost{-1.};
+	std::string chosen;
+	// Outcome of the last attempt
+	SolveStatus attemptStatus{SolveStatus::NotSolved};
+	// Stall of the open method being tried
+	BasicStallWatch<Real> watch;
+
+	// The solvers are built again with the new function
+	void functionChanged() override
+	{
+		fs.f = this->f;
+		solvers.clear();
+		fCost = -1.;
+	}
+
+	// Candidate chosen from the history
+	std::string pick(const std::vector<std::string>& candidates) const;
+
+	// True for the methods that do not keep a bracket
+	static bool isOpen(const std::string& name) {return name == "Newton" || name == "Secant";}
+
+	// Solve with the method within what is left of the limits, true if it converged; an open method is stopped if it stalls
+	bool attempt(const std::string& name, const Parameters& q, Real& zero);
+};
+
+template<class Traits>
+std::string BasicAutoSolver<Traits>::pick(const std::vector<std::string>& candidates) const
+{
+	if (history->next() % explorePeriod == 0)
+		for (const std::string& c : candidates)
+			if (history->get(c).solves < minSolves)
+				return c;
+
+	std::string best = candidates.front();
+	double bestCost = std::numeric_limits<double>::infinity();
+	for (const std::string& c : candidates)
+	{
+		const AutoHistory::Record r = history->get(c);
+		if (r.solves >= minSolves && 10 * r.failures <= r.solves && r.meanCost() < bestCost)
+		{
+			best = c;
+			bestCost = r.meanCost();
+		}
+	}
+	return best;
+}
+
+template<class Traits>
+bool BasicAutoSolver<Traits>::attempt(const std::string& name, const Parameters& q, Real& zero)
+{
+	// Limits left by the probes and the previous attempts
+	Parameters left = q;
+	left.maxIt = std::min(q.maxIt, params.maxIt > this->stats.iterations ? params.maxIt - this->stats.iterations : 0u);
+	BasicStoppingPolicy<Traits> p = this->policy;
+	if (this->usePolicy && p.maxEvals > 0)
+	{
+		const std::size_t used = this->stats.fEvals + this->stats.dfEvals - this->policyEvals;
+		p.maxEvals = (used < p.maxEvals) ? p.maxEvals - used : 0u;
+	}
+	if (this->usePolicy && p.deadline > 0)
+		p.deadline -= std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - this->policyStart).count();
+	if (left.maxIt == 0 || (this->usePolicy && ((this->policy.maxEvals > 0 && p.maxEvals == 0) || (this->policy.deadline > 0 && p.deadline <= 0))))
+	{
+		attemptStatus = (left.maxIt == 0) ? SolveStatus::MaxIterations : (p.deadline <= 0 && this->policy.deadline > 0) ? SolveStatus::DeadlineExceeded : SolveStatus::BudgetExhausted;
+		return false;
+	}
+
+	std::unique_ptr<BasicSolverBase<Traits>>& solver = solvers[name];
+	if (solver)
+		solver->reset(left);
+	else
+		solver = BasicSolverFactory<Traits>().make_solver(name, fs, left);
+	// The policy applies to every attempt, the open ones also stop when they stall
+	watch.clear();
+	if (isOpen(name))
+		p.custom = [this, custom = this->policy.custom](const Real& x, const Real& dx, const Real& fx)
+			{return (custom && custom(x, dx, fx)) || watch(dx, fx);};
+	solver->setStoppingPolicy(p);
+
+	BasicSolveStats<Traits> s = solver->solveWithStats();
+	if (watch.stalled)
+		s.status = SolveStatus::Stalled;
+	this->stats.fEvals += s.fEvals;
+	this->stats.dfEvals += s.dfEvals;
+	this->stats.iterations += s.iterations;
+	this->stats.residual = s.residual;
+	this->stats.bracketWidth = s.bracketWidth;
+	history->add(name, s.ok(), s.fEvals * fCost + s.dfEvals * dfCost);
+	chosen = name;
+	zero = s.zero;
+	attemptStatus = s.status;
+	return s.ok();
+}
+
+// Auto solver implementation
+/*!
+ * @return The approximation of the zero (NaN if not found)
+ */
+template<class Traits>
+auto BasicAutoSolver<Traits>::solve() -> Real
+{
+	this->beginSolve();
+	this->stats.iterations = 0u;
+	const Real ya = this->evalF(params.a);
+	const Real yb = this->evalF(params.b);
+	const bool bracket = (ya * yb <= 0);
+	const bool derivative = static_cast<bool>(fs.df);
+
+	// Cost of one evaluation, timed once per function
+	if (fCost < 0.)
+	{
+		const Real m = (params.a + params.b) / 2;
+		auto start = std::chrono::steady_clock::now();
+		this->evalF(m);
+		fCost = std::max(1e-9, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+		dfCost = fCost;
+		if (derivative)
+		{
+			start = std::chrono::steady_clock::now();
+			fs.df(m);
+			++this->stats.dfEvals;
+			dfCost = std::max(1e-9, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+		}
+	}
+
+	std::vector<std::string> candidates;
+	if (bracket)
+	{
+		if (derivative)
+			candidates.push_back("SafeNewton");
+		candidates.push_back("Brent");
+		candidates.push_back("Secant");
+	}
+	else
+	{
+		if (derivative)
+			candidates.push_back("Newton");
+		candidates.push_back("Secant");
+	}
+	const std::string first = pick(candidates);
+
+	Parameters q = params;
+	if (!bracket)
+		q.maxIt = std::min(q.maxIt, openBudget);
+	Real zero;
+	bool ok = attempt(first, q, zero);
+	// Stagnation, oscillation or no convergence: Brent searches a bracket
+	if (!ok && first != "Brent" && attemptStatus != SolveStatus::BudgetExhausted && attemptStatus != SolveStatus::DeadlineExceeded)
+	{
+		Logger::log(LogLevel::Info, "Auto: ", first, attemptStatus == SolveStatus::Stalled ? " stalled" : " did not converge", ", switching to Brent");
+		ok = attempt("Brent", params, zero);
+	}
+
+	const unsigned int iter = this->stats.iterations;
+	this->setStats(attemptStatus, iter, this->stats.residual, this->stats.bracketWidth);
+	return ok ? zero : std::numeric_limits<Real>::quiet_NaN();
+}
+
+using AutoSolver = BasicAutoSolver<SolverTraits>;
+
+#endif
@@ -0,0 +1,294 @@
+#include "BatchMode.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include "BinaryBatch.hpp"
+#include "ParallelSolveDriver.hpp"
+#include "SolverFactory.hpp"
+
+// Removes the blanks at the extremes of s
+static std::string trim(const std::string& s)
+{
+	const auto begin = s.find_first_not_of(" \t\r");
+	if (begin == std::string::npos)
+		return "";
+	const auto end = s.find_last_not_of(" \t\r");
+	return s.substr(begin, end - begin + 1);
+}
+
+// Sets the parameter called name, false if there is no such parameter
+static bool setParameter(SolverParameters& p, const std::string& name, const double& value)
+{
+	if (name == "a") p.a = value;
+	else if (name == "b") p.b = value;
+	else if (name == "tol") p.tol = value;
+	else if (name == "tola") p.tola = value;
+	else if (name == "maxIt") p.maxIt = static_cast<unsigned int>(value);
+	else if (name == "h_interval") p.h_interval = value;
+	else if (name == "maxIter") p.maxIter = static_cast<unsigned int>(value);
+	else if (name == "x0") p.x0 = value;
+	else if (name == "h") p.h = value;
+	else if (name == "sections") p.sections = static_cast<unsigned int>(value);
+	else if (name == "refresh") p.refresh = static_cast<unsigned int>(value);
+	else return false;
+	return true;
+}
+
+CsvProblemReader::CsvProblemReader(std::istream& in_, const SolverParameters& defaults_) : in(in_), defaults(defaults_)
+{
+	std::string header;
+	while (std::getline(in, header))
+	{
+		++line;
+		header = trim(header);
+		if (!header.empty() && header[0] != '#')
+			break;
+	}
+
+	std::istringstream names(header);
+	std::string name;
+	SolverParameters check;
+	while (std::getline(names, name, ','))
+	{
+		name = trim(name);
+		if (!setParameter(check, name, 0.))
+		{
+			message = "unknown column \"" + name + "\"";
+			return;
+		}
+		columns.push_back(name);
+	}
+	if (columns.empty())
+		message = "missing header";
+}
+
+bool CsvProblemReader::next(SolverParameters& p)
+{
+	if (!message.empty())
+		return false;
+
+	std::string record;
+	while (std::getline(in, record))
+	{
+		++line;
+		record = trim(record);
+		if (record.empty() || record[0] == '#')
+			continue;
+
+		p = defaults;
+		std::istringstream fields(record);
+		std::string field;
+		std::size_t k = 0;
+		while (std::getline(fields, field, ','))
+		{
+			field = trim(field);
+			char* end = nullptr;
+			const double value = std::strtod(field.c_str(), &end);
+			if (k >= columns.size() || field.empty() || *end != '\0')
+			{
+				message = "invalid record at line " + std::to_string(line);
+				return false;
+			}
+			setParameter(p, columns[k++], value);
+		}
+		if (k != columns.size())
+		{
+			message = "missing values at line " + std::to_string(line);
+			return false;
+		}
+		return true;
+	}
+	return false;
+}
+
+// Kernels of DeviceBatchSolver used by the batch mode
+struct BatchKernels
+{
+	// False for the solvers of the factory
+	bool use{false};
+	BatchBackend backend{BatchBackend::Cpu};
+};
+
+// Kernels of the backend called name (empty for none), the error if they cannot solve with the method
+static std::string batchKernels(const std::string& name, const std::string& method, const SolverFunctions& fs, BatchKernels& kernels)
+{
+	kernels.use = !name.empty();
+	if (!kernels.use)
+		return "";
+	if (name == "cpu")
+		kernels.backend = BatchBackend::Cpu;
+	else if (name == "gpu")
+		kernels.backend = BatchBackend::Gpu;
+	else
+		return "invalid backend " + name + ", the backends are cpu and gpu";
+	if (!ParallelSolveDriver::hasDeviceMethod(method))
+		return "the backend " + name + " solves only with the methods Bisection, Brent and Newton";
+	if (method == "Newton" && !fs.df)
+		return "the method Newton needs the derivative";
+	if (kernels.backend == BatchBackend::Gpu && !DeviceBatchSolver::gpuAvailable())
+		std::cout << "WARNING, no CUDA device available (or not compiled by nvcc), the batch is solved on the CPU" << std::endl;
+	return "";
+}
+
+// Solves a batch with the solvers of the factory or with the kernels
+static bool solveBatch(ParallelSolveDriver& driver, const BatchKernels& kernels, const std::string& method, const SolverFunctions& fs, const SolverParameters& defaults, const ProblemBatch& problems, ResultBatch& results)
+{
+	if (!kernels.use)
+		return driver.solve(method, fs, defaults, problems, results);
+	// The functions are called on the host
+	using Real = SolverTraits::Real;
+	const auto f = [&fs](const Real& x, std::size_t) {return fs.f(x);};
+	const auto df = [&fs](const Real& x, std::size_t) {return fs.df(x);};
+	return driver.solve(kernels.backend, method, f, df, defaults, problems, results);
+}
+
+// Batch mode on binary batch files, see runBatch
+static int runBinaryBatch(const std::string& method, const SolverFunctions& fs, const SolverParameters& defaults, const std::string& input, const std::string& output, unsigned int nThreads, bool resume, const BatchKernels& kernels)
+{
+	// Problems solved between two checkpoints
+	constexpr std::size_t chunkSize = 1 << 16;
+
+	if (!SolverFactory::hasMethod(method))
+	{
+		std::cout << "ERROR, invalid method" << std::endl;
+		return 1;
+	}
+
+	BinaryProblemFile in(input);
+	if (!in.error().empty())
+	{
+		std::cout << "ERROR, " << input << ": " << in.error() << std::endl;
+		return 1;
+	}
+	const std::size_t n = in.size();
+	BinaryResultFile out(output, n, resume);
+	if (!out.error().empty())
+	{
+		std::cout << "ERROR, " << output << ": " << out.error() << std::endl;
+		return 1;
+	}
+
+	// The solves read the mapped problems and write the mapped results in place
+	ParallelSolveDriver driver(nThreads);
+	const std::size_t first = out.completed();
+	std::size_t solved{0};
+	for (std::size_t begin = first; begin < n; begin += chunkSize)
+	{
+		const std::size_t end = std::min(n, begin + chunkSize);
+		ResultBatch results = out.results(begin, end);
+		if (!solveBatch(driver, kernels, method, fs, defaults, in.problems(begin, end), results))
+		{
+			std::cout << "ERROR, the method " << method << " needs functions not given" << std::endl;
+			return 1;
+		}
+		solved += results.converged();
+		if (!out.checkpoint(end))
+		{
+			std::cout << "ERROR, " << output << ": " << out.error() << std::endl;
+			return 1;
+		}
+	}
+	std::cout << "Solved " << solved << " of " << n - first << " problems";
+	if (first > 0)
+		std::cout << " (resumed at " << first << ")";
+	std::cout << " with " << method << " method, results in " << output << std::endl;
+
+	return 0;
+}
+
+int runBatch(const std::string& method, const SolverFunctions& fs, const SolverParameters& defaults, const std::string& input, const std::string& output, unsigned int nThreads, bool resume, const std::string& backend)
+{
+	BatchKernels kernels;
+	const std::string error = batchKernels(backend, method, fs, kernels);
+	if (!error.empty())
+	{
+		std::cout << "ERROR, " << error << std::endl;
+		return 1;
+	}
+	if (BinaryBatch::isProblemFile(input))
+		return runBinaryBatch(method, fs, defaults, input, output, nThreads, resume, kernels);
+
+	// Problems solved together, bounds the memory used
+	constexpr std::size_t chunkSize = 8192;
+
+	std::ifstream in(input);
+	if (!in)
+	{
+		std::cout << "ERROR, cannot open " << input << std::endl;
+		return 1;
+	}
+	std::ofstream out(output);
+	if (!out)
+	{
+		std::cout << "ERROR, cannot open " << output << std::endl;
+		return 1;
+	}
+	out.precision(std::numeric_limits<SolverTraits::Real>::max_digits10);
+	out << "index,zero,status,iterations,fEvals,dfEvals\n";
+
+	CsvProblemReader reader(in, defaults);
+	const SolverFactory factory;
+	ParallelSolveDriver driver(nThreads);
+	std::vector<std::unique_ptr<SolverBase>> solvers;
+	SolverParameters p;
+	std::size_t index{0}, solved{0};
+	bool more{true};
+
+	// Problems of a chunk for the kernels, in the arena
+	Arena arena;
+	while (more && kernels.use)
+	{
+		arena.reset();
+		ProblemBatch problems(arena);
+		ResultBatch results(arena);
+		while (problems.size() < chunkSize && (more = reader.next(p)))
+			problems.push_back({p.a, p.b, p.x0}, p.tol);
+		solveBatch(driver, kernels, method, fs, defaults, problems, results);
+		for (std::size_t i = 0; i < results.size(); ++i)
+		{
+			out << index++ << ',' << results.zero()[i] << ',' << toString(results.status()[i]) << ',' << results.iterations()[i] << ',' << results.fEvals()[i] << ',' << results.dfEvals()[i] << '\n';
+			solved += (results.status()[i] == SolveStatus::Converged);
+		}
+	}
+
+	while (more)
+	{
+		// The solvers of the previous chunk are reset, not built again
+		std::size_t n{0};
+		while (n < chunkSize && (more = reader.next(p)))
+		{
+			if (n < solvers.size())
+				solvers[n]->reset(p);
+			else
+			{
+				solvers.push_back(factory.make_solver(method, fs, p));
+				if (!solvers.back())
+				{
+					std::cout << "ERROR, invalid method" << std::endl;
+					return 1;
+				}
+			}
+			++n;
+		}
+		solvers.resize(n);
+
+		for (const auto& stats : driver.solveWithStats(solvers))
+		{
+			out << index++ << ',' << stats.zero << ',' << toString(stats.status) << ',' << stats.iterations << ',' << stats.fEvals << ',' << stats.dfEvals << '\n';
+			solved += stats.ok();
+		}
+	}
+
+	if (!reader.error().empty())
+	{
+		std::cout << "ERROR, " << input << ": " << reader.error() << std::endl;
+		return 1;
+	}
+	std::cout << "Solved " << solved << " of " << index << " problems with " << method << " method, results in " << output << std::endl;
+
+	return 0;
+}
@@ -0,0 +1,63 @@
+#ifndef _BATCH_MODE_HPP_
+#define _BATCH_MODE_HPP_
+
+#include <istream>
+#include <string>
+#include <vector>
+#include "SolverParameters.hpp"
+
+/* * * * * * * * * * * * * * * * * * * * * *
+ * Reader of problems from a CSV file      *
+ * * * * * * * * * * * * * * * * * * * * * */
+/*!
+ * The first line is a header with the names of the columns, any subset of
+ * a, b, tol, tola, maxIt, h_interval, maxIter, x0, h, sections, refresh
+ * (same names of data.dat). Every following line is a problem: the parameters that are not
+ * in the columns take the default value. Empty lines and lines starting
+ * with # are skipped.
+ */
+class CsvProblemReader
+{
+public:
+	// Constructor, reads the header
+	CsvProblemReader(std::istream& in_, const SolverParameters& defaults_);
+
+	// Reads the next problem, false at the end of the file or on error
+	bool next(SolverParameters& p);
+
+	// Description of the error, empty if there is none
+	const std::string& error() const {return message;}
+
+private:
+	std::istream& in;
+	SolverParameters defaults;
+	// Names of the columns
+	std::vector<std::string> columns;
+	// Number of the line read last
+	unsigned long line{0};
+	std::string message;
+};
+
+// Batch mode of the main program
+/*!
+ * Reads the problems from the CSV file input, solves them with the given
+ * method on nThreads threads and writes one line per problem to output:
+ * index, zero, status, iterations and evaluations of f and df.
+ * The file is processed in chunks, so the memory used does not depend on
+ * the number of problems.
+ * If input is a binary batch file of problems (BinaryBatch.hpp), output
+ * is the binary batch file of the results: both are mapped in memory and
+ * the solves read and write them in place, with a checkpoint after every
+ * chunk. With resume, a run on an output of the same number of problems
+ * starts from its checkpoint.
+ * With backend "cpu" or "gpu" the methods Bisection, Brent and Newton run
+ * the kernels of DeviceBatchSolver on that backend instead of the solvers
+ * of the factory: only a, b, x0 and tol change from a problem to another,
+ * the other parameters are the defaults. The functions of fs run on the
+ * host, so the GPU backend falls back to the CPU with a warning.
+ *
+ * @return the exit code of the program
+ */
+int runBatch(const std::string& method, const SolverFunctions& fs, const SolverParameters& defaults, const std::string& input, const std::string& output, unsigned int nThreads, bool resume = false, const std::string& backend = "");
+
+#endif
@@ -0,0 +1,249 @@
+#include "BinaryBatch.hpp"
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using Real = SolverTraits::Real;
+
+MappedFile::MappedFile(const std::string& path, Mode mode, std::size_t size_)
+{
+	const bool write = (mode == Mode::Write);
+	fd = ::open(path.c_str(), write ? (O_RDWR | O_CREAT) : O_RDONLY, 0644);
+	if (fd < 0)
+	{
+		message = "cannot open " + path + ": " + std::strerror(errno);
+		return;
+	}
+	struct stat st;
+	if (write && size_ > 0 && ::ftruncate(fd, static_cast<off_t>(size_)) != 0)
+	{
+		message = "cannot resize " + path + ": " + std::strerror(errno);
+		return;
+	}
+	if (::fstat(fd, &st) != 0)
+	{
+		message = "cannot read the size of " + path + ": " + std::strerror(errno);
+		return;
+	}
+	length = static_cast<std::size_t>(st.st_size);
+	if (length == 0)
+		return;
+	void* p = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, write ? MAP_SHARED : MAP_PRIVATE, fd, 0);
+	if (p == MAP_FAILED)
+	{
+		message = "cannot map " + path + ": " + std::strerror(errno);
+		length = 0;
+		return;
+	}
+	bytes = static_cast<unsigned char*>(p);
+	// The batches are read front to back
+	::madvise(p, length, MADV_SEQUENTIAL);
+}
+
+MappedFile::~MappedFile()
+{
+	if (bytes)
+		::munmap(bytes, length);
+	if (fd >= 0)
+		::close(fd);
+}
+
+bool MappedFile::sync(std::size_t offset, std::size_t n)
+{
+	if (n == 0)
+		return true;
+	// msync starts at a page
+	const std::size_t page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+	const std::size_t begin = offset / page * page;
+	if (::msync(bytes + begin, offset + n - begin, MS_SYNC) != 0)
+	{
+		message = std::string("cannot write the mapped file: ") + std::strerror(errno);
+		return false;
+	}
+	return true;
+}
+
+namespace BinaryBatch
+{
+	// Written as a whole, read back in the byte order of the machine
+	constexpr std::uint32_t byteOrderMark = 0x01020304;
+
+	Header header(const char (&magic)[8], std::size_t count)
+	{
+		Header h{};
+		std::memcpy(h.magic, magic, sizeof(h.magic));
+		h.count = count;
+		h.completed = 0;
+		h.byteOrder = byteOrderMark;
+		h.realSize = sizeof(Real);
+		h.statusSize = sizeof(SolveStatus);
+		h.unsignedSize = sizeof(unsigned int);
+		h.sizeSize = sizeof(std::size_t);
+		return h;
+	}
+
+	std::string check(const Header& h, const char (&magic)[8])
+	{
+		if (std::memcmp(h.magic, magic, sizeof(h.magic)) != 0)
+			return "not a binary batch file of this kind";
+		if (h.byteOrder != byteOrderMark || h.realSize != sizeof(Real) || h.statusSize != sizeof(SolveStatus) ||
+			h.unsignedSize != sizeof(unsigned int) || h.sizeSize != sizeof(std::size_t))
+			return "binary batch file written by a machine with a different layout of the values";
+		return "";
+	}
+
+	bool isProblemFile(const std::string& path)
+	{
+		char magic[sizeof(problemMagic)];
+		std::ifstream in(path, std::ios::binary);
+		return in.read(magic, sizeof(magic)) && std::memcmp(magic, problemMagic, sizeof(magic)) == 0;
+	}
+}
+
+BinaryProblemFile::BinaryProblemFile(const std::string& path) : file(path, MappedFile::Mode::Read)
+{
+	if (!file.error().empty())
+	{
+		message = file.error();
+		return;
+	}
+	if (file.size() < sizeof(BinaryBatch::Header))
+	{
+		message = path + " is too short for a binary batch file";
+		return;
+	}
+	const auto& h = *reinterpret_cast<const BinaryBatch::Header*>(file.data());
+	message = BinaryBatch::check(h, BinaryBatch::problemMagic);
+	if (!message.empty())
+		return;
+	const std::size_t column = BinaryBatch::columnBytes(h.count, sizeof(Real));
+	if (file.size() < sizeof(h) + 4 * column)
+	{
+		message = path + " is shorter than its " + std::to_string(h.count) + " problems";
+		return;
+	}
+	n = h.count;
+	for (std::size_t k = 0; k < 4; ++k)
+		columns[k] = reinterpret_cast<Real*>(file.data() + sizeof(h) + k * column);
+}
+
+ProblemBatch BinaryProblemFile::problems(std::size_t begin, std::size_t end)
+{
+	return ProblemBatch(columns[0] + begin, columns[1] + begin, columns[2] + begin, columns[3] + begin, end - begin);
+}
+
+bool BinaryProblemFile::write(const std::string& path, const ProblemBatch& problems)
+{
+	const std::size_t n = problems.size();
+	const std::size_t column = BinaryBatch::columnBytes(n, sizeof(Real));
+	MappedFile file(path, MappedFile::Mode::Write, sizeof(BinaryBatch::Header) + 4 * column);
+	if (!file.error().empty())
+		return false;
+	const BinaryBatch::Header h = BinaryBatch::header(BinaryBatch::problemMagic, n);
+	std::memcpy(file.data(), &h, sizeof(h));
+	const Real* from[4] = {problems.a(), problems.b(), problems.x0(), problems.tol()};
+	for (std::size_t k = 0; k < 4; ++k)
+		if (n > 0)
+			std::memcpy(file.data() + sizeof(h) + k * column, from[k], n * sizeof(Real));
+	return file.sync(0, file.size());
+}
+
+BinaryResultFile::BinaryResultFile(const std::string& path, std::size_t n_, bool resume) :
+	file(path, MappedFile::Mode::Write, fileSize(n_)), n(n_)
+{
+	if (!file.error().empty())
+	{
+		message = file.error();
+		return;
+	}
+	// A file of other problems, or not of results, is started again
+	const BinaryBatch::Header& h = header();
+	if (!resume || !BinaryBatch::check(h, BinaryBatch::resultMagic).empty() || h.count != n || h.completed > n)
+		header() = BinaryBatch::header(BinaryBatch::resultMagic, n);
+	mapColumns();
+}
+
+BinaryResultFile::BinaryResultFile(const std::string& path) : file(path, MappedFile::Mode::Write)
+{
+	if (!file.error().empty())
+	{
+		message = file.error();
+		return;
+	}
+	if (file.size() < sizeof(BinaryBatch::Header))
+	{
+		message = path + " is too short for a binary batch file";
+		return;
+	}
+	message = BinaryBatch::check(header(), BinaryBatch::resultMagic);
+	if (!message.empty())
+		return;
+	n = header().count;
+	if (file.size() < fileSize(n))
+	{
+		message = path + " is shorter than its " + std::to_string(n) + " results";
+		n = 0;
+		return;
+	}
+	mapColumns();
+}
+
+std::size_t BinaryResultFile::completed() const
+{
+	return file.data() ? header().completed : 0;
+}
+
+ResultBatch BinaryResultFile::results(std::size_t begin, std::size_t end)
+{
+	return ResultBatch(zeros + begin, statuses + begin, iters + begin, fEvalCounts + begin, dfEvalCounts + begin, end - begin);
+}
+
+bool BinaryResultFile::checkpoint(std::size_t done)
+{
+	// The results reach the file before the header that counts them
+	const std::size_t from = completed();
+	auto save = [&](const void* column, std::size_t size)
+	{
+		const std::size_t offset = static_cast<const unsigned char*>(column) - file.data();
+		return file.sync(offset + from * size, (done - from) * size);
+	};
+	if (done > from && !(save(zeros, sizeof(Real)) && save(statuses, sizeof(SolveStatus)) && save(iters, sizeof(unsigned int)) &&
+		save(fEvalCounts, sizeof(std::size_t)) && save(dfEvalCounts, sizeof(std::size_t))))
+	{
+		message = file.error();
+		return false;
+	}
+	header().completed = done;
+	if (!file.sync(0, sizeof(BinaryBatch::Header)))
+	{
+		message = file.error();
+		return false;
+	}
+	return true;
+}
+
+std::size_t BinaryResultFile::fileSize(std::size_t n_)
+{
+	using BinaryBatch::columnBytes;
+	return sizeof(BinaryBatch::Header) + columnBytes(n_, sizeof(Real)) + columnBytes(n_, sizeof(SolveStatus)) +
+		columnBytes(n_, sizeof(unsigned int)) + 2 * columnBytes(n_, sizeof(std::size_t));
+}
+
+void BinaryResultFile::mapColumns()
+{
+	using BinaryBatch::columnBytes;
+	unsigned char* p = file.data() + sizeof(BinaryBatch::Header);
+	zeros = reinterpret_cast<Real*>(p);
+	p += columnBytes(n, sizeof(Real));
+	statuses = reinterpret_cast<SolveStatus*>(p);
+	p += columnBytes(n, sizeof(SolveStatus));
+	iters = reinterpret_cast<unsigned int*>(p);
+	p += columnBytes(n, sizeof(unsigned int));
+	fEvalCounts = reinterpret_cast<std::size_t*>(p);
+	p += columnBytes(n, sizeof(std::size_t));
+	dfEvalCounts = reinterpret_cast<std::size_t*>(p);
+}
@@ -0,0 +1,167 @@
+#ifndef _BINARY_BATCH_HPP_
+#define _BINARY_BATCH_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "SolverBatch.hpp"
+
+/* * * * * * * * * * * * * * * * * * * * *
+ * File mapped in memory                  *
+ * * * * * * * * * * * * * * * * * * * * */
+/*!
+ * A Read mapping is private: the pages are read from the file on demand
+ * and can be written, but the writes do not reach the file. A Write
+ * mapping is shared with the file, which is created, or resized, with the
+ * given size if it is not 0.
+ */
+class MappedFile
+{
+public:
+	enum class Mode {Read, Write};
+
+	MappedFile(const std::string& path, Mode mode, std::size_t size_ = 0);
+	~MappedFile();
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	unsigned char* data() {return bytes;}
+	const unsigned char* data() const {return bytes;}
+	std::size_t size() const {return length;}
+
+	// Writes the bytes [offset, offset + n) to the file, false on error
+	bool sync(std::size_t offset, std::size_t n);
+
+	// Description of the error, empty if there is none
+	const std::string& error() const {return message;}
+
+private:
+	unsigned char* bytes{nullptr};
+	std::size_t length{0};
+	int fd{-1};
+	std::string message;
+};
+
+/* * * * * * * * * * * * * * * * * * * * *
+ * Binary batch files                     *
+ * * * * * * * * * * * * * * * * * * * * */
+/*!
+ * A binary batch file is a header of 64 bytes followed by the columns of
+ * the batch, one after the other, each starting at a multiple of 64 bytes
+ * as the columns of a ProblemBatch or ResultBatch in the arena, so that a
+ * mapped file is used in place with no copy. The files of problems have
+ * the columns a, b, x0 and tol (Real), the files of results zero (Real),
+ * status (SolveStatus), iterations (unsigned int), fEvals and dfEvals
+ * (std::size_t). The values are in the layout of the machine that wrote
+ * them, checked by the header.
+ */
+namespace BinaryBatch
+{
+	struct Header
+	{
+		char magic[8];
+		// Number of problems
+		std::uint64_t count;
+		// Problems solved, the checkpoint of a file of results
+		std::uint64_t completed;
+		// Byte order and sizes of the values, written by the machine
+		std::uint32_t byteOrder;
+		std::uint32_t realSize;
+		std::uint32_t statusSize;
+		std::uint32_t unsignedSize;
+		std::uint32_t sizeSize;
+		unsigned char unused[20];
+	};
+	static_assert(sizeof(Header) == Arena::alignment, "the columns start after a header of 64 bytes");
+
+	constexpr char problemMagic[8] = "ZFPROBS";
+	constexpr char resultMagic[8] = "ZFRSLTS";
+
+	// Header of the files written by this machine
+	Header header(const char (&magic)[8], std::size_t count);
+
+	// Error if the header is not of a file of the kind with the layout of this machine, empty if there is none
+	std::string check(const Header& h, const char (&magic)[8]);
+
+	// Bytes of a column of n values of the given size, padded to 64
+	inline std::size_t columnBytes(std::size_t n, std::size_t size) {return (n * size + Arena::alignment - 1) / Arena::alignment * Arena::alignment;}
+
+	// True if the file at path starts as a file of problems
+	bool isProblemFile(const std::string& path);
+}
+
+// Problems of a binary batch file, mapped in memory
+class BinaryProblemFile
+{
+public:
+	explicit BinaryProblemFile(const std::string& path);
+
+	// Number of problems
+	std::size_t size() const {return n;}
+
+	// View of the problems [begin, end), the pages are read on demand
+	ProblemBatch problems(std::size_t begin, std::size_t end);
+
+	// Description of the error, empty if there is none
+	const std::string& error() const {return message;}
+
+	// Writes the problems to a binary batch file, false on error
+	static bool write(const std::string& path, const ProblemBatch& problems);
+
+private:
+	MappedFile file;
+	std::size_t n{0};
+	SolverTraits::Real* columns[4]{};
+	std::string message;
+};
+
+// Results of a binary batch file, mapped in memory
+/*!
+ * The results written in the view are saved to the file by checkpoint,
+ * which also records the number of problems solved in the header: a run
+ * interrupted can be resumed from there.
+ */
+class BinaryResultFile
+{
+public:
+	// Opens the file for the results of n problems, keeping the solved ones if resume and the file is of n problems
+	BinaryResultFile(const std::string& path, std::size_t n_, bool resume);
+
+	// Opens an existing file of results
+	explicit BinaryResultFile(const std::string& path);
+
+	// Number of results
+	std::size_t size() const {return n;}
+
+	// Problems solved, recorded by the last checkpoint
+	std::size_t completed() const;
+
+	// View of the results [begin, end)
+	ResultBatch results(std::size_t begin, std::size_t end);
+
+	// Saves the results up to done, then records done as solved, false on error
+	bool checkpoint(std::size_t done);
+
+	// Description of the error, empty if there is none
+	const std::string& error() const {return message;}
+
+private:
+	MappedFile file;
+	std::size_t n{0};
+	SolverTraits::Real* zeros{nullptr};
+	SolveStatus* statuses{nullptr};
+	unsigned int* iters{nullptr};
+	std::size_t* fEvalCounts{nullptr};
+	std::size_t* dfEvalCounts{nullptr};
+	std::string message;
+
+	// Bytes of the file for n_ results
+	static std::size_t fileSize(std::size_t n_);
+	// Sets the columns in the mapped file
+	void mapColumns();
+	BinaryBatch::Header& header() {return *reinterpret_cast<BinaryBatch::Header*>(file.data());}
+	const BinaryBatch::Header& header() const {return *reinterpret_cast<const BinaryBatch::Header*>(file.data());}
+};
+
+#endif
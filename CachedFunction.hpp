@@ -0,0 +1,98 @@
+#ifndef _CACHED_FUNCTION_HPP_
+#define _CACHED_FUNCTION_HPP_
+
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
+#include "SolverTraits.hpp"
+
+/* * * * * * * * * * * * * * * * * * * * *
+ * Function with a cache of its values   *
+ * * * * * * * * * * * * * * * * * * * * */
+/*!
+ * Wraps a function f and stores its values in a small direct-mapped table:
+ * every x is mapped to one slot, which is overwritten on a collision. A call
+ * with the same x of the value in its slot (same value and same sign, so
+ * that +0 and -0 are distinct) returns the stored value without calling f.
+ * Useful when f is costly and the same points are evaluated again: the
+ * extremes of the bracket found by the search of a valid interval, which
+ * setInterval evaluates again, the probes of Auto at a and b, evaluated
+ * again by its attempts, or the same problem solved more than once. The
+ * points of a single solve, as x, x + h, x - h of QuasiNewton, are all
+ * distinct and give no hit.
+ *
+ * The table is shared by the copies of the object, so it can be passed by
+ * value to a solver (also as a std::function) and queried afterwards.
+ * It is not thread safe: use one object per thread.
+ */
+template<class Traits, class F = typename Traits::FunType>
+class CachedFunction
+{
+public:
+	using Real = typename Traits::Real;
+
+	// Constructor, the size of the table is rounded up to a power of two
+	explicit CachedFunction(const F& f_, std::size_t size = 64) : f(f_), table(std::make_shared<Table>())
+	{
+		std::size_t n = 1;
+		while (n < size)
+			n *= 2;
+		table->slots.resize(n);
+	}
+
+	Real operator()(const Real& x) const
+	{
+		Slot& slot = table->slots[std::hash<Real>{}(x) & (table->slots.size() - 1)];
+		if (slot.valid && slot.x == x && std::signbit(slot.x) == std::signbit(x))
+		{
+			++table->hits;
+			return slot.y;
+		}
+		++table->evaluations;
+		slot.x = x;
+		slot.y = f(x);
+		slot.valid = true;
+		return slot.y;
+	}
+
+	// Number of calls of the wrapped function
+	std::size_t evaluations() const {return table->evaluations;}
+
+	// Number of calls answered by the cache (evaluations saved)
+	std::size_t hits() const {return table->hits;}
+
+	// Empties the table and resets the counters
+	void clear()
+	{
+		for (auto& slot : table->slots)
+			slot.valid = false;
+		table->evaluations = 0;
+		table->hits = 0;
+	}
+
+private:
+	struct Slot
+	{
+		Real x{0.};
+		Real y{0.};
+		bool valid{false};
+	};
+
+	struct Table
+	{
+		std::vector<Slot> slots;
+		std::size_t evaluations{0};
+		std::size_t hits{0};
+	};
+
+	F f;
+	std::shared_ptr<Table> table;
+};
+
+// Deduce F from the argument, the traits default to SolverTraits
+template<class F, class ... Args>
+CachedFunction(const F&, const Args&...) -> CachedFunction<SolverTraits, F>;
+
+#endif
@@ -0,0 +1,74 @@
+#include "CompiledConfig.hpp"
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+
+static_assert(std::is_trivially_copyable<SolverParameters>::value, "the parameters are written as they are in memory");
+
+namespace
+{
+	constexpr char magic[8] = "ZFCONF1";
+
+	struct Header
+	{
+		char magic[8];
+		std::uint32_t parametersSize;
+		std::uint32_t realSize;
+		std::uint64_t coefficients;
+	};
+
+	struct Close
+	{
+		void operator()(std::FILE* f) const {std::fclose(f);}
+	};
+	using File = std::unique_ptr<std::FILE, Close>;
+}
+
+CompiledConfig::CompiledConfig(const std::string& path)
+{
+	// A missing or short file, or one of text, is not compiled
+	const File in(std::fopen(path.c_str(), "rb"));
+	Header h;
+	if (!in || std::fread(&h, sizeof(h), 1, in.get()) != 1 || std::memcmp(h.magic, magic, sizeof(magic)) != 0)
+		return;
+	isCompiled = true;
+	if (h.parametersSize != sizeof(SolverParameters) || h.realSize != sizeof(Real))
+	{
+		message = path + " was compiled by a build with a different layout of the parameters";
+		return;
+	}
+	// The count of the header is checked against the length of the file before the allocation
+	long length{-1};
+	if (std::fseek(in.get(), 0, SEEK_END) == 0)
+		length = std::ftell(in.get());
+	if (length < 0 || std::fseek(in.get(), sizeof(h), SEEK_SET) != 0)
+	{
+		message = "cannot read the length of " + path;
+		return;
+	}
+	const std::uint64_t available = static_cast<std::uint64_t>(length);
+	const std::uint64_t fixed = sizeof(h) + sizeof(SolverParameters);
+	if (available < fixed || h.coefficients > (available - fixed) / sizeof(Real))
+	{
+		message = path + " is truncated";
+		return;
+	}
+	coefficients.resize(h.coefficients);
+	if (std::fread(&parameters, sizeof(parameters), 1, in.get()) != 1 ||
+		std::fread(coefficients.data(), sizeof(Real), coefficients.size(), in.get()) != coefficients.size())
+		message = path + " is truncated";
+}
+
+bool CompiledConfig::write(const std::string& path, const SolverParameters& p, const std::vector<Real>& coefficients)
+{
+	const File out(std::fopen(path.c_str(), "wb"));
+	Header h{};
+	std::memcpy(h.magic, magic, sizeof(magic));
+	h.parametersSize = sizeof(SolverParameters);
+	h.realSize = sizeof(Real);
+	h.coefficients = coefficients.size();
+	return out && std::fwrite(&h, sizeof(h), 1, out.get()) == 1 && std::fwrite(&p, sizeof(p), 1, out.get()) == 1 &&
+		std::fwrite(coefficients.data(), sizeof(Real), coefficients.size(), out.get()) == coefficients.size() && std::fflush(out.get()) == 0;
+}
@@ -0,0 +1,44 @@
+#ifndef _COMPILED_CONFIG_HPP_
+#define _COMPILED_CONFIG_HPP_
+
+#include <string>
+#include <vector>
+#include "SolverParameters.hpp"
+
+/* * * * * * * * * * * * * * * * * * * * *
+ * Precompiled data file                  *
+ * * * * * * * * * * * * * * * * * * * * */
+/*!
+ * The parameters of a data file and the coefficients of the polynomial in
+ * binary form: a header (magic, sizes of the parameters and of the values,
+ * number of coefficients), the SolverParameters as they are in memory and
+ * the coefficients. Reading it is a single read of a few hundred bytes,
+ * with no parsing. The file is valid only for a build with the same layout
+ * of SolverParameters, which is checked by the header.
+ */
+class CompiledConfig
+{
+public:
+	using Real = SolverTraits::Real;
+
+	// Reads the file at path, if it is a compiled configuration
+	explicit CompiledConfig(const std::string& path);
+
+	// True if the file is a compiled configuration, else it is left to GetPot
+	bool compiled() const {return isCompiled;}
+
+	// Description of the error, empty if there is none
+	const std::string& error() const {return message;}
+
+	SolverParameters parameters;
+	std::vector<Real> coefficients;
+
+	// Writes a compiled configuration, false on error
+	static bool write(const std::string& path, const SolverParameters& p, const std::vector<Real>& coefficients);
+
+private:
+	bool isCompiled{false};
+	std::string message;
+};
+
+#endif
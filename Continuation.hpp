@@ -0,0 +1,180 @@
+#ifndef _CONTINUATION_HPP_
+#define _CONTINUATION_HPP_
+
+#include <cmath>
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include "classZeroFun.hpp"
+
+// Order of the extrapolation of the previous zeros
+enum class ContinuationOrder {Constant, Linear, Quadratic};
+
+/* * * * * * * * * * * * * * * * * * * * * * * *
+ * Continuation solver for parameter sweeps    *
+ * * * * * * * * * * * * * * * * * * * * * * * */
+/*!
+ * Solves g(x; p) = 0 for a sequence of parameters p_0, p_1, ... that
+ * change smoothly. The starting state of every solve is predicted from the
+ * zeros of the previous ones, extrapolated in p with a polynomial of
+ * degree up to 2, so that only a few iterations are needed.
+ * With the Brent method the bracket is centered on the prediction, with
+ * half width 4 times the error of the last prediction (the last change of
+ * the zero if it was not predicted): the iterations of Brent grow with the
+ * log of the width over tol. If it does not contain the zero it is
+ * expanded with the golden-section search.
+ * With the Newton method the prediction is the starting point.
+ * The solver is built by the first solve and then retargeted, the first
+ * solve (and the first after a failure) starts from the initial state.
+ */
+template<class Traits, class G = typename Traits::ParamFunType, class DG = G>
+class BasicContinuation
+{
+public:
+	using Real = typename Traits::Real;
+
+	// Sweep with the Brent method, [a, b] is the bracket of the first problem
+	BasicContinuation(const G& g_, const Real& a_, const Real& b_, const Real& tol_, const unsigned int& maxIt_, const ContinuationOrder& order_ = ContinuationOrder::Quadratic) :
+		g(g_), dg(g_), useBrent(true), a0(a_), b0(b_), x0(a_), tol(tol_), tola(0.), maxIt(maxIt_), order(order_) {}
+
+	// Sweep with the Newton method, x0 is the starting point of the first problem
+	BasicContinuation(const G& g_, const DG& dg_, const Real& x0_, const Real& tol_, const Real& tola_, const unsigned int& maxIt_, const ContinuationOrder& order_ = ContinuationOrder::Quadratic) :
+		g(g_), dg(dg_), useBrent(false), a0(x0_), b0(x0_), x0(x0_), tol(tol_), tola(tola_), maxIt(maxIt_), order(order_) {}
+
+	// The solvers refer to the members of this object
+	BasicContinuation(const BasicContinuation&) = delete;
+	BasicContinuation& operator=(const BasicContinuation&) = delete;
+
+	// Solves g(x; p_) = 0 starting from the prediction
+	Real solve(const Real& p_) {return solveWithStats(p_).zero;}
+
+	// Solves g(x; p_) = 0 starting from the prediction, with the statistics of the solve
+	BasicSolveStats<Traits> solveWithStats(const Real& p_);
+
+	// Forgets the previous zeros, the next solve starts from the initial state
+	void restart() {count = 0;}
+
+private:
+	// g at fixed parameter
+	struct Slice
+	{
+		const G* g;
+		const Real* p;
+		Real operator()(const Real& x) const {return (*g)(x, *p);}
+	};
+	// dg at fixed parameter
+	struct DSlice
+	{
+		const DG* dg;
+		const Real* p;
+		Real operator()(const Real& x) const {return (*dg)(x, *p);}
+	};
+
+	G g;
+	DG dg;
+	// Current parameter
+	Real p{0.};
+	// True for the Brent method, false for Newton
+	bool useBrent;
+	// Initial bracket
+	Real a0;
+	Real b0;
+	// Initial point
+	Real x0;
+	// Parameters of the solver
+	Real tol;
+	Real tola;
+	unsigned int maxIt;
+	ContinuationOrder order;
+	std::unique_ptr<BasicBrent<Traits, Slice>> brent;
+	std::unique_ptr<BasicNewton<Traits, Slice, DSlice>> newton;
+
+	// Last parameters and zeros, the most recent first
+	Real ps[3];
+	Real xs[3];
+	std::size_t count{0};
+	// Prediction of the current solve, NaN if it starts from the initial state
+	Real prediction{std::numeric_limits<Real>::quiet_NaN()};
+	// Error of the prediction of the last solve, NaN if it was not predicted
+	Real error{std::numeric_limits<Real>::quiet_NaN()};
+
+	// Extrapolation of the previous zeros at p_
+	Real predict(const Real& p_) const;
+};
+
+template<class Traits, class G, class DG>
+auto BasicContinuation<Traits, G, DG>::predict(const Real& p_) const -> Real
+{
+	const std::size_t n = std::min<std::size_t>(count, static_cast<std::size_t>(order) + 1);
+	// Lagrange interpolation of the last n zeros
+	Real x{0.};
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		Real l{1.};
+		for (std::size_t j = 0; j < n; ++j)
+			if (j != i)
+				l *= (p_ - ps[j]) / (ps[i] - ps[j]);
+		x += l * xs[i];
+	}
+	// Repeated parameters, use the last zero
+	return std::isfinite(x) ? x : xs[0];
+}
+
+// Solve of the next problem of the sweep
+/*!
+ * @return the zero and the statistics of the solve
+ */
+template<class Traits, class G, class DG>
+auto BasicContinuation<Traits, G, DG>::solveWithStats(const Real& p_) -> BasicSolveStats<Traits>
+{
+	p = p_;
+	prediction = (count == 0) ? std::numeric_limits<Real>::quiet_NaN() : predict(p);
+	if (useBrent)
+	{
+		if (!brent)
+			brent = std::make_unique<BasicBrent<Traits, Slice>>(Slice{&g, &p}, a0, b0, tol, maxIt, (b0 - a0) / 4, 200, BracketStrategy::Golden);
+		else if (count == 0)
+		{
+			brent->setBracketStep((b0 - a0) / 4);
+			brent->setInterval(a0, b0);
+		}
+		else
+		{
+			// The error of the prediction changes slowly along a smooth sweep: a
+			// few times the last one, else the last change of the zero
+			const Real change = (count > 1) ? std::abs(xs[0] - xs[1]) : (b0 - a0) / 4;
+			const Real w = (std::isnan(error) ? change : 4 * error) + 2 * tol;
+			brent->setBracketStep(w);
+			brent->setInterval(prediction - w, prediction + w);
+		}
+	}
+	else
+	{
+		if (!newton)
+			newton = std::make_unique<BasicNewton<Traits, Slice, DSlice>>(Slice{&g, &p}, DSlice{&dg, &p}, x0, tol, tola, maxIt);
+		newton->setStart(count == 0 ? x0 : prediction);
+	}
+
+	BasicSolveStats<Traits> stats = useBrent ? brent->solveWithStats() : newton->solveWithStats();
+	if (stats.ok())
+	{
+		for (std::size_t i = 2; i > 0; --i)
+		{
+			ps[i] = ps[i - 1];
+			xs[i] = xs[i - 1];
+		}
+		ps[0] = p;
+		xs[0] = stats.zero;
+		error = std::abs(prediction - stats.zero);
+		count = std::min<std::size_t>(count + 1, 3);
+	}
+	else
+		count = 0;
+
+	return stats;
+}
+
+using Continuation = BasicContinuation<SolverTraits>;
+
+#endif
@@ -0,0 +1,312 @@
+#ifndef _DEVICE_BATCH_SOLVER_HPP_
+#define _DEVICE_BATCH_SOLVER_HPP_
+
+#include <cstddef>
+#include <limits>
+#include "SolveStats.hpp"
+#include "SolverBatch.hpp"
+#include "SolverTraits.hpp"
+#include "Logger.hpp"
+#include "ThreadPool.hpp"
+
+// Functions callable on the host and, when compiled by nvcc, on the device
+#ifdef __CUDACC__
+#define ZEROFUN_HOST_DEVICE __host__ __device__
+#else
+#define ZEROFUN_HOST_DEVICE
+#endif
+
+/* * * * * * * * * * * * * * * * * * * * * * * * *
+ * Kernels of one problem, for host and device   *
+ * * * * * * * * * * * * * * * * * * * * * * * * */
+/*!
+ * The algorithms of Bisection, Brent and Newton (classZeroFun_impl.hpp)
+ * on problem i, with no allocation, no exception, no log and no std
+ * function, so that the same code runs in a CUDA thread: f is a functor
+ * called as f(x, i), as for BatchSolver, and must be callable on the
+ * device. They return the zero (NaN if not found) and set the status and
+ * the iterations, with the same outcomes of the scalar solvers (the
+ * bracket is not searched when f does not change sign).
+ */
+namespace DeviceKernels
+{
+	template<class Real>
+	ZEROFUN_HOST_DEVICE inline Real absolute(const Real& x) {return x < 0 ? -x : x;}
+
+	template<class Real>
+	ZEROFUN_HOST_DEVICE inline Real notFound() {return std::numeric_limits<Real>::quiet_NaN();}
+
+	template<class Real, class Kernel>
+	ZEROFUN_HOST_DEVICE Real bisection(const Kernel& f, std::size_t i, Real a, Real b, const Real& tol, const unsigned int& maxIt, SolveStatus& status, unsigned int& iter)
+	{
+		Real ya = f(a, i);
+		const Real yb = f(b, i);
+		iter = 0u;
+		if (!(ya * yb <= 0))
+		{
+			status = SolveStatus::InvalidInterval;
+			return notFound<Real>();
+		}
+		// Bounded also by maxIt: with tol below half an ulp of the zero the midpoint rounds to a or b
+		while (absolute(b - a) > 2 * tol && iter < maxIt)
+		{
+			++iter;
+			const Real c = (a + b) / 2;
+			const Real yc = f(c, i);
+			if (yc * ya < 0)
+				b = c;
+			else
+			{
+				a = c;
+				ya = yc;
+			}
+		}
+		const bool converged = !(absolute(b - a) > 2 * tol);
+		status = converged ? SolveStatus::Converged : SolveStatus::MaxIterations;
+		return converged ? (a + b) / 2 : notFound<Real>();
+	}
+
+	template<class Real, class Kernel>
+	ZEROFUN_HOST_DEVICE Real brent(const Kernel& f, std::size_t i, Real a, Real b, const Real& tol, const unsigned int& maxIt, SolveStatus& status, unsigned int& iter)
+	{
+		Real ya = f(a, i);
+		Real yb = f(b, i);
+		iter = 0u;
+		if (!(ya * yb < 0))
+		{
+			status = (ya == 0 || yb == 0) ? SolveStatus::Converged : SolveStatus::InvalidInterval;
+			return (ya == 0) ? a : (yb == 0) ? b : notFound<Real>();
+		}
+		if (absolute(ya) < absolute(yb))
+		{
+			const Real t = a; a = b; b = t;
+			const Real yt = ya; ya = yb; yb = yt;
+		}
+		Real c = a;
+		Real d = c;
+		Real yc = ya;
+		bool mflag{true};
+		Real s = b;
+		Real ys = yb;
+		do
+		{
+			++iter;
+			if (ya != yc && yb != yc)
+				s = a * ya * yc / ((ya - yb) * (ya - yc)) + b * ya * yc / ((ya - yb) * (yc - yb)) - c * ya * yb / ((ya - yc) * (yc - yb));
+			else
+				s = b - yb * (b - a) / (yb - ya);
+			if (((s - 3 * (a + b) / 4) * (s - b) >= 0) ||
+				(mflag && (absolute(s - b) >= absolute(b - c) / 2)) ||
+				(!mflag && (absolute(s - b) >= absolute(c - d) / 2)) ||
+				(mflag && (absolute(b - c) < tol)) ||
+				(!mflag && (absolute(c - d) < tol)))
+			{
+				mflag = true;
+				s = (a + b) / 2;
+			}
+			else
+				mflag = false;
+			ys = f(s, i);
+			d = c;
+			c = b;
+			yc = yb;
+			if (ya * ys < 0)
+			{
+				b = s;
+				yb = ys;
+			}
+			else
+			{
+				a = s;
+				ya = ys;
+			}
+			if (absolute(ya) < absolute(yb))
+			{
+				const Real t = a; a = b; b = t;
+				const Real yt = ya; ya = yb; yb = yt;
+			}
+		}
+		while (ys != 0 && absolute(b - a) > tol && iter < maxIt);
+		status = (iter < maxIt) ? SolveStatus::Converged : SolveStatus::MaxIterations;
+		return (iter < maxIt) ? s : notFound<Real>();
+	}
+
+	template<class Real, class Kernel, class DKernel>
+	ZEROFUN_HOST_DEVICE Real newton(const Kernel& f, const DKernel& df, std::size_t i, Real x, const Real& tol, const Real& tola, const unsigned int& maxIt, SolveStatus& status, unsigned int& iter)
+	{
+		Real y = f(x, i);
+		const Real check = tol * absolute(y) + tola;
+		iter = 0u;
+		while (absolute(y) > check && iter < maxIt)
+		{
+			++iter;
+			x -= y / df(x, i);
+			y = f(x, i);
+		}
+		// x - x is NaN for infinite or NaN x
+		status = !(x - x == 0) ? SolveStatus::Diverged : (iter < maxIt) ? SolveStatus::Converged : SolveStatus::MaxIterations;
+		return (status == SolveStatus::Converged) ? x : notFound<Real>();
+	}
+}
+
+// Backend of a DeviceBatchSolver
+enum class BatchBackend
+{
+	Cpu, // the workers of a ThreadPool
+	Gpu  // a CUDA device, if compiled by nvcc (GpuBatchSolver.cuh)
+};
+
+#ifdef __CUDACC__
+#include "GpuBatchSolver.cuh"
+#endif
+
+/* * * * * * * * * * * * * * * * * * * * * * * * *
+ * Batches of problems on the CPU or on the GPU  *
+ * * * * * * * * * * * * * * * * * * * * * * * * */
+/*!
+ * Solves n independent problems given as structure of arrays: the inputs
+ * a, b (or x0) and the outputs x, status and iterations have one entry per
+ * problem, status and iterations may be null. Every problem runs the
+ * kernel of DeviceKernels: on the CPU backend the problems are split among
+ * the workers of the pool, on the GPU backend one CUDA thread solves one
+ * problem and the batch is streamed to the device in chunks, with the
+ * transfers of a chunk overlapped to the kernels of the previous one.
+ * Without nvcc, or without a device, the GPU backend falls back to the CPU
+ * with a warning. The overloads on a ProblemBatch and a ResultBatch take
+ * the columns of the batch and its tolerances.
+ */
+class DeviceBatchSolver
+{
+public:
+	using T = SolverTraits;
+	using Real = T::Real;
+
+	DeviceBatchSolver(const Real& tol_, const Real& tola_, const unsigned int& maxIt_, const BatchBackend& backend_ = BatchBackend::Cpu, ThreadPool& pool_ = ThreadPool::shared()) :
+		tol(tol_), tola(tola_), maxIt(maxIt_), backend(backend_), pool(&pool_)
+	{
+		if (backend == BatchBackend::Gpu && !gpuAvailable())
+		{
+			Logger::log(LogLevel::Warning, "No CUDA device available, the batches are solved on the CPU");
+			backend = BatchBackend::Cpu;
+		}
+	}
+
+	// True if a CUDA device can be used
+	static bool gpuAvailable()
+	{
+#ifdef __CUDACC__
+		return GpuBatch::deviceCount() > 0;
+#else
+		return false;
+#endif
+	}
+
+	// Backend in use
+	BatchBackend usedBackend() const {return backend;}
+
+	// Bisection on the brackets [a[i], b[i]], with tolerances tols[i] if not null
+	template<class Kernel>
+	void bisection(const Kernel& f, const Real* a, const Real* b, Real* x, SolveStatus* status, unsigned int* iterations, std::size_t n, const Real* tols = nullptr) const
+	{
+#ifdef __CUDACC__
+		if (backend == BatchBackend::Gpu)
+			return GpuBatch::bisection(f, a, b, x, status, iterations, n, tol, maxIt, tols);
+#endif
+		const Real tol_ = tol;
+		const unsigned int maxIt_ = maxIt;
+		forEach(n, status, iterations, [&](std::size_t i, SolveStatus& s, unsigned int& it)
+			{x[i] = DeviceKernels::bisection(f, i, a[i], b[i], tols ? tols[i] : tol_, maxIt_, s, it);});
+	}
+
+	// Brent on the brackets [a[i], b[i]], with tolerances tols[i] if not null
+	template<class Kernel>
+	void brent(const Kernel& f, const Real* a, const Real* b, Real* x, SolveStatus* status, unsigned int* iterations, std::size_t n, const Real* tols = nullptr) const
+	{
+#ifdef __CUDACC__
+		if (backend == BatchBackend::Gpu)
+			return GpuBatch::brent(f, a, b, x, status, iterations, n, tol, maxIt, tols);
+#endif
+		const Real tol_ = tol;
+		const unsigned int maxIt_ = maxIt;
+		forEach(n, status, iterations, [&](std::size_t i, SolveStatus& s, unsigned int& it)
+			{x[i] = DeviceKernels::brent(f, i, a[i], b[i], tols ? tols[i] : tol_, maxIt_, s, it);});
+	}
+
+	// Newton from the starting points x0[i], with the derivative df and tolerances tols[i] if not null
+	template<class Kernel, class DKernel>
+	void newton(const Kernel& f, const DKernel& df, const Real* x0, Real* x, SolveStatus* status, unsigned int* iterations, std::size_t n, const Real* tols = nullptr) const
+	{
+#ifdef __CUDACC__
+		if (backend == BatchBackend::Gpu)
+			return GpuBatch::newton(f, df, x0, x, status, iterations, n, tol, tola, maxIt, tols);
+#endif
+		const Real tol_ = tol;
+		const Real tola_ = tola;
+		const unsigned int maxIt_ = maxIt;
+		forEach(n, status, iterations, [&](std::size_t i, SolveStatus& s, unsigned int& it)
+			{x[i] = DeviceKernels::newton(f, df, i, x0[i], tols ? tols[i] : tol_, tola_, maxIt_, s, it);});
+	}
+
+	// The same methods on the columns of a batch, with its tolerances
+	template<class Kernel>
+	void bisection(const Kernel& f, const ProblemBatch& problems, ResultBatch& results) const
+	{
+		results.resize(problems.size());
+		bisection(f, problems.a(), problems.b(), results.zero(), results.status(), results.iterations(), problems.size(), problems.tol());
+		countEvals(results, 2, 1, 0);
+	}
+
+	template<class Kernel>
+	void brent(const Kernel& f, const ProblemBatch& problems, ResultBatch& results) const
+	{
+		results.resize(problems.size());
+		brent(f, problems.a(), problems.b(), results.zero(), results.status(), results.iterations(), problems.size(), problems.tol());
+		countEvals(results, 2, 1, 0);
+	}
+
+	template<class Kernel, class DKernel>
+	void newton(const Kernel& f, const DKernel& df, const ProblemBatch& problems, ResultBatch& results) const
+	{
+		results.resize(problems.size());
+		newton(f, df, problems.x0(), results.zero(), results.status(), results.iterations(), problems.size(), problems.tol());
+		countEvals(results, 1, 1, 1);
+	}
+
+private:
+	// Tolerance
+	Real tol;
+	// Absolute tolerance
+	Real tola;
+	// Maximum number of iterations (Brent, Newton)
+	unsigned int maxIt;
+	BatchBackend backend;
+	ThreadPool* pool;
+
+	// Evaluations of f (first + perIter per iteration) and of df (dfPerIter per iteration)
+	static void countEvals(ResultBatch& results, std::size_t first, std::size_t perIter, std::size_t dfPerIter)
+	{
+		for (std::size_t i = 0; i < results.size(); ++i)
+		{
+			results.fEvals()[i] = first + perIter * results.iterations()[i];
+			results.dfEvals()[i] = dfPerIter * results.iterations()[i];
+		}
+	}
+
+	// Runs solve(i, status, iterations) for every problem on the pool
+	template<class Solve>
+	void forEach(std::size_t n, SolveStatus* status, unsigned int* iterations, const Solve& solve) const
+	{
+		pool->parallelFor(n, [&](std::size_t i)
+		{
+			SolveStatus s;
+			unsigned int it;
+			solve(i, s, it);
+			if (status)
+				status[i] = s;
+			if (iterations)
+				iterations[i] = it;
+		});
+	}
+};
+
+#endif
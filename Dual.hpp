@@ -0,0 +1,99 @@
+#ifndef _DUAL_HPP_
+#define _DUAL_HPP_
+
+#include <cmath>
+
+/* * * * * * * * * * * * * * * * * * * * * * * *
+ * Dual numbers for forward-mode differentiation *
+ * * * * * * * * * * * * * * * * * * * * * * * * */
+/*!
+ * A dual number v + d e, with e^2 = 0. Evaluating a function written for a
+ * generic argument on Dual{x, 1} gives f(x) in v and f'(x) in d, with the
+ * accuracy of the evaluation of f. The functions must be called
+ * unqualified, e.g.
+ *
+ *   auto f = [](const auto& x) {using std::exp; return 0.5 - exp(M_PI * x);};
+ */
+template<class R>
+struct Dual
+{
+	using value_type = R;
+
+	Dual() = default;
+	// A constant, with null derivative
+	Dual(const R& v_, const R& d_ = R(0)) : v(v_), d(d_) {}
+
+	// Value
+	R v{0};
+	// Derivative
+	R d{0};
+
+	Dual& operator+=(const Dual& y) {v += y.v; d += y.d; return *this;}
+	Dual& operator-=(const Dual& y) {v -= y.v; d -= y.d; return *this;}
+	Dual& operator*=(const Dual& y) {d = d * y.v + v * y.d; v *= y.v; return *this;}
+	Dual& operator/=(const Dual& y) {d = (d * y.v - v * y.d) / (y.v * y.v); v /= y.v; return *this;}
+};
+
+// The real operand is not deduced, so that e.g. 2 * x works for Dual<double>
+template<class R>
+using DualScalar = typename Dual<R>::value_type;
+
+// Arithmetic
+template<class R> Dual<R> operator+(const Dual<R>& x) {return x;}
+template<class R> Dual<R> operator-(const Dual<R>& x) {return {-x.v, -x.d};}
+
+template<class R> Dual<R> operator+(Dual<R> x, const Dual<R>& y) {return x += y;}
+template<class R> Dual<R> operator-(Dual<R> x, const Dual<R>& y) {return x -= y;}
+template<class R> Dual<R> operator*(Dual<R> x, const Dual<R>& y) {return x *= y;}
+template<class R> Dual<R> operator/(Dual<R> x, const Dual<R>& y) {return x /= y;}
+
+template<class R> Dual<R> operator+(const Dual<R>& x, const DualScalar<R>& c) {return {x.v + c, x.d};}
+template<class R> Dual<R> operator+(const DualScalar<R>& c, const Dual<R>& x) {return {c + x.v, x.d};}
+template<class R> Dual<R> operator-(const Dual<R>& x, const DualScalar<R>& c) {return {x.v - c, x.d};}
+template<class R> Dual<R> operator-(const DualScalar<R>& c, const Dual<R>& x) {return {c - x.v, -x.d};}
+template<class R> Dual<R> operator*(const Dual<R>& x, const DualScalar<R>& c) {return {x.v * c, x.d * c};}
+template<class R> Dual<R> operator*(const DualScalar<R>& c, const Dual<R>& x) {return {c * x.v, c * x.d};}
+template<class R> Dual<R> operator/(const Dual<R>& x, const DualScalar<R>& c) {return {x.v / c, x.d / c};}
+template<class R> Dual<R> operator/(const DualScalar<R>& c, const Dual<R>& x) {return {c / x.v, -c * x.d / (x.v * x.v)};}
+
+// Comparisons, on the values
+template<class R> bool operator==(const Dual<R>& x, const Dual<R>& y) {return x.v == y.v;}
+template<class R> bool operator!=(const Dual<R>& x, const Dual<R>& y) {return x.v != y.v;}
+template<class R> bool operator<(const Dual<R>& x, const Dual<R>& y) {return x.v < y.v;}
+template<class R> bool operator>(const Dual<R>& x, const Dual<R>& y) {return x.v > y.v;}
+template<class R> bool operator<=(const Dual<R>& x, const Dual<R>& y) {return x.v <= y.v;}
+template<class R> bool operator>=(const Dual<R>& x, const Dual<R>& y) {return x.v >= y.v;}
+
+template<class R> bool operator==(const Dual<R>& x, const DualScalar<R>& c) {return x.v == c;}
+template<class R> bool operator!=(const Dual<R>& x, const DualScalar<R>& c) {return x.v != c;}
+template<class R> bool operator<(const Dual<R>& x, const DualScalar<R>& c) {return x.v < c;}
+template<class R> bool operator>(const Dual<R>& x, const DualScalar<R>& c) {return x.v > c;}
+template<class R> bool operator<=(const Dual<R>& x, const DualScalar<R>& c) {return x.v <= c;}
+template<class R> bool operator>=(const Dual<R>& x, const DualScalar<R>& c) {return x.v >= c;}
+
+// Elementary functions, by the chain rule
+template<class R> Dual<R> exp(const Dual<R>& x) {const R e = std::exp(x.v); return {e, e * x.d};}
+template<class R> Dual<R> log(const Dual<R>& x) {return {std::log(x.v), x.d / x.v};}
+template<class R> Dual<R> sqrt(const Dual<R>& x) {const R s = std::sqrt(x.v); return {s, x.d / (2 * s)};}
+template<class R> Dual<R> sin(const Dual<R>& x) {return {std::sin(x.v), std::cos(x.v) * x.d};}
+template<class R> Dual<R> cos(const Dual<R>& x) {return {std::cos(x.v), -std::sin(x.v) * x.d};}
+template<class R> Dual<R> tan(const Dual<R>& x) {const R t = std::tan(x.v); return {t, (1 + t * t) * x.d};}
+template<class R> Dual<R> atan(const Dual<R>& x) {return {std::atan(x.v), x.d / (1 + x.v * x.v)};}
+template<class R> Dual<R> sinh(const Dual<R>& x) {return {std::sinh(x.v), std::cosh(x.v) * x.d};}
+template<class R> Dual<R> cosh(const Dual<R>& x) {return {std::cosh(x.v), std::sinh(x.v) * x.d};}
+template<class R> Dual<R> tanh(const Dual<R>& x) {const R t = std::tanh(x.v); return {t, (1 - t * t) * x.d};}
+template<class R> Dual<R> abs(const Dual<R>& x) {return x.v < 0 ? -x : x;}
+
+// Power with a real exponent, exact at x = 0 for integer exponents
+template<class R> Dual<R> pow(const Dual<R>& x, const DualScalar<R>& c)
+{
+	return {std::pow(x.v, c), c == 0 ? R(0) : c * std::pow(x.v, c - 1) * x.d};
+}
+// Power with a dual exponent, x must be positive
+template<class R> Dual<R> pow(const Dual<R>& x, const Dual<R>& y)
+{
+	const R p = std::pow(x.v, y.v);
+	return {p, p * (y.d * std::log(x.v) + y.v * x.d / x.v)};
+}
+
+#endif
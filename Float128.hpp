@@ -0,0 +1,93 @@
+#ifndef _FLOAT128_HPP_
+#define _FLOAT128_HPP_
+
+/*
+ * Support of the quadruple precision type __float128 of GCC, for the
+ * traits Float128SolverTraits: the functions of <cmath> used by the
+ * solvers, computed by libquadmath (link with -lquadmath), its
+ * numeric_limits and its output on a stream. Only where the compiler has
+ * the type (__SIZEOF_FLOAT128__) and in the GNU dialect, where the
+ * standard library knows it as a floating point type (std::abs included).
+ */
+#if defined(__SIZEOF_FLOAT128__) && !defined(__STRICT_ANSI__) && !defined(__CUDACC__)
+#define ZEROFUN_FLOAT128 1
+
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <limits>
+#include <ostream>
+#include <quadmath.h>
+
+namespace std
+{
+	inline __float128 sqrt(__float128 x) {return sqrtq(x);}
+	inline __float128 exp(__float128 x) {return expq(x);}
+	inline __float128 log(__float128 x) {return logq(x);}
+	inline __float128 pow(__float128 x, __float128 y) {return powq(x, y);}
+	inline __float128 sin(__float128 x) {return sinq(x);}
+	inline __float128 cos(__float128 x) {return cosq(x);}
+	inline __float128 tan(__float128 x) {return tanq(x);}
+	inline __float128 atan(__float128 x) {return atanq(x);}
+	inline __float128 acos(__float128 x) {return acosq(x);}
+	inline __float128 sinh(__float128 x) {return sinhq(x);}
+	inline __float128 cosh(__float128 x) {return coshq(x);}
+	inline __float128 tanh(__float128 x) {return tanhq(x);}
+	inline __float128 ceil(__float128 x) {return ceilq(x);}
+	inline __float128 copysign(__float128 x, __float128 y) {return copysignq(x, y);}
+	inline __float128 nextafter(__float128 x, __float128 y) {return nextafterq(x, y);}
+	inline bool isnan(__float128 x) {return isnanq(x);}
+	inline bool isinf(__float128 x) {return isinfq(x);}
+	inline bool isfinite(__float128 x) {return finiteq(x);}
+	inline bool signbit(__float128 x) {return signbitq(x);}
+
+	template<>
+	struct numeric_limits<__float128>
+	{
+		static constexpr bool is_specialized = true;
+		static constexpr bool is_signed = true;
+		static constexpr bool is_integer = false;
+		static constexpr bool is_exact = false;
+		static constexpr bool has_infinity = true;
+		static constexpr bool has_quiet_NaN = true;
+		static constexpr bool is_iec559 = true;
+		static constexpr int digits = FLT128_MANT_DIG;
+		static constexpr int digits10 = FLT128_DIG;
+		static constexpr int max_digits10 = 36;
+		static constexpr int radix = 2;
+		static constexpr int min_exponent = FLT128_MIN_EXP;
+		static constexpr int max_exponent = FLT128_MAX_EXP;
+		static constexpr __float128 min() noexcept {return FLT128_MIN;}
+		static constexpr __float128 max() noexcept {return FLT128_MAX;}
+		static constexpr __float128 lowest() noexcept {return -FLT128_MAX;}
+		static constexpr __float128 epsilon() noexcept {return FLT128_EPSILON;}
+		static constexpr __float128 denorm_min() noexcept {return FLT128_DENORM_MIN;}
+		static constexpr __float128 infinity() noexcept {return __builtin_huge_valq();}
+		static constexpr __float128 quiet_NaN() noexcept {return __builtin_nanq("");}
+	};
+
+	// Hash of the bits of the value, for CachedFunction
+	template<>
+	struct hash<__float128>
+	{
+		std::size_t operator()(const __float128& x) const noexcept
+		{
+			const __float128 y = (x == 0) ? __float128(0) : x;
+			unsigned long long w[2];
+			__builtin_memcpy(w, &y, sizeof(w));
+			return std::hash<unsigned long long>{}(w[0] ^ (w[1] * 0x9e3779b97f4a7c15ull));
+		}
+	};
+}
+
+// Written with the precision of the stream, in scientific notation
+inline std::ostream& operator<<(std::ostream& out, const __float128& x)
+{
+	const int digits = static_cast<int>(out.precision() > 0 ? out.precision() : 6);
+	char buffer[64];
+	quadmath_snprintf(buffer, sizeof(buffer), "%.*Qg", digits, x);
+	return out << buffer;
+}
+#endif
+
+#endif
@@ -0,0 +1,172 @@
+#ifndef _GPU_BATCH_SOLVER_CUH_
+#define _GPU_BATCH_SOLVER_CUH_
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <cuda_runtime.h>
+
+/* * * * * * * * * * * * * * * * * * * * *
+ * CUDA backend of DeviceBatchSolver      *
+ * * * * * * * * * * * * * * * * * * * * */
+/*!
+ * Included by DeviceBatchSolver.hpp when compiled by nvcc, which needs
+ * --expt-relaxed-constexpr (numeric_limits in the kernels) and, for f
+ * given as a lambda, --extended-lambda with f marked __host__ __device__.
+ * The problems are streamed in chunks on two streams: the copy of the
+ * inputs of a chunk, its kernel (one thread per problem) and the copy of
+ * its results are queued on one stream while the other works on the
+ * previous chunk. The copies overlap the kernels only if the host arrays
+ * are pinned (cudaHostAlloc or cudaHostRegister).
+ * CUDA errors are reported with a std::runtime_error.
+ */
+namespace GpuBatch
+{
+	using Real = SolverTraits::Real;
+
+	// Problems per chunk
+	constexpr std::size_t chunk = std::size_t(1) << 20;
+	constexpr unsigned int threadsPerBlock = 256;
+
+	inline void check(cudaError_t error, const char* what)
+	{
+		if (error != cudaSuccess)
+			throw std::runtime_error(std::string("CUDA error in ") + what + ": " + cudaGetErrorString(error));
+	}
+
+	inline int deviceCount()
+	{
+		int n{0};
+		return (cudaGetDeviceCount(&n) == cudaSuccess) ? n : 0;
+	}
+
+	// Array on the device
+	template<class X>
+	struct DeviceArray
+	{
+		X* p{nullptr};
+
+		explicit DeviceArray(std::size_t n) {check(cudaMalloc(&p, n * sizeof(X)), "cudaMalloc");}
+		~DeviceArray() {cudaFree(p);}
+		DeviceArray(const DeviceArray&) = delete;
+		DeviceArray& operator=(const DeviceArray&) = delete;
+	};
+
+	// Device arrays of a chunk
+	struct ChunkArrays
+	{
+		DeviceArray<Real> in0;
+		DeviceArray<Real> in1;
+		DeviceArray<Real> tol;
+		DeviceArray<Real> x;
+		DeviceArray<SolveStatus> status;
+		DeviceArray<unsigned int> iterations;
+
+		explicit ChunkArrays(std::size_t m) : in0(m), in1(m), tol(m), x(m), status(m), iterations(m) {}
+	};
+
+	// Solve of one problem by each method, in0 and in1 are a and b (x0 for Newton), t the tolerance
+	template<class Kernel>
+	struct BisectionSolve
+	{
+		Kernel f;
+		Real tol;
+		unsigned int maxIt;
+		__device__ Real operator()(std::size_t i, Real a, Real b, Real t, SolveStatus& s, unsigned int& it) const {return DeviceKernels::bisection(f, i, a, b, t, maxIt, s, it);}
+	};
+
+	template<class Kernel>
+	struct BrentSolve
+	{
+		Kernel f;
+		Real tol;
+		unsigned int maxIt;
+		__device__ Real operator()(std::size_t i, Real a, Real b, Real t, SolveStatus& s, unsigned int& it) const {return DeviceKernels::brent(f, i, a, b, t, maxIt, s, it);}
+	};
+
+	template<class Kernel, class DKernel>
+	struct NewtonSolve
+	{
+		Kernel f;
+		DKernel df;
+		Real tol;
+		Real tola;
+		unsigned int maxIt;
+		__device__ Real operator()(std::size_t i, Real x0, Real, Real t, SolveStatus& s, unsigned int& it) const {return DeviceKernels::newton(f, df, i, x0, t, tola, maxIt, s, it);}
+	};
+
+	// One thread per problem of the chunk starting at offset
+	template<class Solve>
+	__global__ void solveKernel(Solve solve, std::size_t offset, std::size_t m, const Real* in0, const Real* in1, const Real* tol, Real* x, SolveStatus* status, unsigned int* iterations)
+	{
+		const std::size_t j = blockIdx.x * static_cast<std::size_t>(blockDim.x) + threadIdx.x;
+		if (j < m)
+		{
+			SolveStatus s;
+			unsigned int it;
+			x[j] = solve(offset + j, in0[j], in1 ? in1[j] : Real(0), tol ? tol[j] : solve.tol, s, it);
+			status[j] = s;
+			iterations[j] = it;
+		}
+	}
+
+	// Streams the n problems through the device, in1, tol, status and iterations may be null
+	template<class Solve>
+	void run(const Solve& solve, const Real* in0, const Real* in1, const Real* tol, Real* x, SolveStatus* status, unsigned int* iterations, std::size_t n)
+	{
+		if (n == 0)
+			return;
+		const std::size_t m = std::min(chunk, n);
+		cudaStream_t streams[2];
+		for (cudaStream_t& s : streams)
+			check(cudaStreamCreate(&s), "cudaStreamCreate");
+		{
+			ChunkArrays arrays[2] = {ChunkArrays(m), ChunkArrays(m)};
+			for (std::size_t offset = 0, k = 0; offset < n; offset += m, ++k)
+			{
+				// The chunk k + 2 reuses the arrays of the chunk k on the same stream, after it
+				cudaStream_t stream = streams[k % 2];
+				ChunkArrays& d = arrays[k % 2];
+				const std::size_t len = std::min(m, n - offset);
+				check(cudaMemcpyAsync(d.in0.p, in0 + offset, len * sizeof(Real), cudaMemcpyHostToDevice, stream), "cudaMemcpyAsync");
+				if (in1)
+					check(cudaMemcpyAsync(d.in1.p, in1 + offset, len * sizeof(Real), cudaMemcpyHostToDevice, stream), "cudaMemcpyAsync");
+				if (tol)
+					check(cudaMemcpyAsync(d.tol.p, tol + offset, len * sizeof(Real), cudaMemcpyHostToDevice, stream), "cudaMemcpyAsync");
+				const unsigned int blocks = static_cast<unsigned int>((len + threadsPerBlock - 1) / threadsPerBlock);
+				solveKernel<<<blocks, threadsPerBlock, 0, stream>>>(solve, offset, len, d.in0.p, in1 ? d.in1.p : nullptr, tol ? d.tol.p : nullptr, d.x.p, d.status.p, d.iterations.p);
+				check(cudaGetLastError(), "solveKernel");
+				check(cudaMemcpyAsync(x + offset, d.x.p, len * sizeof(Real), cudaMemcpyDeviceToHost, stream), "cudaMemcpyAsync");
+				if (status)
+					check(cudaMemcpyAsync(status + offset, d.status.p, len * sizeof(SolveStatus), cudaMemcpyDeviceToHost, stream), "cudaMemcpyAsync");
+				if (iterations)
+					check(cudaMemcpyAsync(iterations + offset, d.iterations.p, len * sizeof(unsigned int), cudaMemcpyDeviceToHost, stream), "cudaMemcpyAsync");
+			}
+			for (cudaStream_t& s : streams)
+				check(cudaStreamSynchronize(s), "cudaStreamSynchronize");
+		}
+		for (cudaStream_t& s : streams)
+			cudaStreamDestroy(s);
+	}
+
+	template<class Kernel>
+	void bisection(const Kernel& f, const Real* a, const Real* b, Real* x, SolveStatus* status, unsigned int* iterations, std::size_t n, Real tol, unsigned int maxIt, const Real* tols)
+	{
+		run(BisectionSolve<Kernel>{f, tol, maxIt}, a, b, tols, x, status, iterations, n);
+	}
+
+	template<class Kernel>
+	void brent(const Kernel& f, const Real* a, const Real* b, Real* x, SolveStatus* status, unsigned int* iterations, std::size_t n, Real tol, unsigned int maxIt, const Real* tols)
+	{
+		run(BrentSolve<Kernel>{f, tol, maxIt}, a, b, tols, x, status, iterations, n);
+	}
+
+	template<class Kernel, class DKernel>
+	void newton(const Kernel& f, const DKernel& df, const Real* x0, Real* x, SolveStatus* status, unsigned int* iterations, std::size_t n, Real tol, Real tola, unsigned int maxIt, const Real* tols)
+	{
+		run(NewtonSolve<Kernel, DKernel>{f, df, tol, tola, maxIt}, x0, nullptr, tols, x, status, iterations, n);
+	}
+}
+
+#endif
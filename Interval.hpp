@@ -0,0 +1,178 @@
+#ifndef _INTERVAL_HPP_
+#define _INTERVAL_HPP_
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+/* * * * * * * * * * * * * * * * * * * * * *
+ * Interval arithmetic, rounded outwards   *
+ * * * * * * * * * * * * * * * * * * * * * */
+/*!
+ * A closed interval [lo, hi]. The result of every operation contains all
+ * the results of the operation on the points of the operands: the bounds
+ * computed in round-to-nearest are moved outwards by one ulp, two for the
+ * elementary functions (the ones of glibc are accurate to less than one
+ * ulp). Evaluating a function written for a generic argument on the
+ * interval X encloses its range on X (the interval extension), e.g.
+ *
+ *   auto f = [](const auto& x) {using std::exp; return 0.5 - exp(M_PI * x);};
+ *   Interval<double> y = f(Interval<double>(0., 1.));
+ *
+ * The functions must be called unqualified, as for Dual.
+ */
+template<class R>
+struct Interval
+{
+	using value_type = R;
+
+	Interval() = default;
+	// The point x
+	Interval(const R& x) : lo(x), hi(x) {}
+	Interval(const R& lo_, const R& hi_) : lo(lo_), hi(hi_) {}
+
+	// Lower bound
+	R lo{0};
+	// Upper bound
+	R hi{0};
+
+	R mid() const {return lo + (hi - lo) / 2;}
+	R width() const {return hi - lo;}
+	bool contains(const R& x) const {return lo <= x && x <= hi;}
+	// True if y is inside the interior of this interval
+	bool interiorContains(const Interval& y) const {return lo < y.lo && y.hi < hi;}
+	bool empty() const {return !(lo <= hi);}
+
+	// The whole real line
+	static Interval entire() {return {-std::numeric_limits<R>::infinity(), std::numeric_limits<R>::infinity()};}
+};
+
+// The real operand is not deduced, so that e.g. 2 * x works for Interval<double>
+template<class R>
+using IntervalScalar = typename Interval<R>::value_type;
+
+namespace IntervalRounding
+{
+	template<class R> R down(const R& x) {return std::nextafter(x, -std::numeric_limits<R>::infinity());}
+	template<class R> R up(const R& x) {return std::nextafter(x, std::numeric_limits<R>::infinity());}
+	// Interval from bounds computed to nearest
+	template<class R> Interval<R> outward(const R& lo, const R& hi) {return {down(lo), up(hi)};}
+	// Interval from bounds computed by the elementary functions
+	template<class R> Interval<R> outward2(const R& lo, const R& hi) {return {down(down(lo)), up(up(hi))};}
+}
+
+// Intersection, empty if x and y are disjoint
+template<class R> Interval<R> intersect(const Interval<R>& x, const Interval<R>& y) {return {std::max(x.lo, y.lo), std::min(x.hi, y.hi)};}
+// Smallest interval containing x and y
+template<class R> Interval<R> hull(const Interval<R>& x, const Interval<R>& y) {return {std::min(x.lo, y.lo), std::max(x.hi, y.hi)};}
+
+// Arithmetic
+template<class R> Interval<R> operator+(const Interval<R>& x) {return x;}
+template<class R> Interval<R> operator-(const Interval<R>& x) {return {-x.hi, -x.lo};}
+
+template<class R> Interval<R> operator+(const Interval<R>& x, const Interval<R>& y) {return IntervalRounding::outward(x.lo + y.lo, x.hi + y.hi);}
+template<class R> Interval<R> operator-(const Interval<R>& x, const Interval<R>& y) {return IntervalRounding::outward(x.lo - y.hi, x.hi - y.lo);}
+template<class R> Interval<R> operator*(const Interval<R>& x, const Interval<R>& y)
+{
+	const R p[] = {x.lo * y.lo, x.lo * y.hi, x.hi * y.lo, x.hi * y.hi};
+	return IntervalRounding::outward(*std::min_element(p, p + 4), *std::max_element(p, p + 4));
+}
+// Division, the whole line if y contains 0
+template<class R> Interval<R> operator/(const Interval<R>& x, const Interval<R>& y)
+{
+	if (y.contains(0))
+		return Interval<R>::entire();
+	const R q[] = {x.lo / y.lo, x.lo / y.hi, x.hi / y.lo, x.hi / y.hi};
+	return IntervalRounding::outward(*std::min_element(q, q + 4), *std::max_element(q, q + 4));
+}
+
+template<class R> Interval<R> operator+(const Interval<R>& x, const IntervalScalar<R>& c) {return x + Interval<R>(c);}
+template<class R> Interval<R> operator+(const IntervalScalar<R>& c, const Interval<R>& x) {return Interval<R>(c) + x;}
+template<class R> Interval<R> operator-(const Interval<R>& x, const IntervalScalar<R>& c) {return x - Interval<R>(c);}
+template<class R> Interval<R> operator-(const IntervalScalar<R>& c, const Interval<R>& x) {return Interval<R>(c) - x;}
+template<class R> Interval<R> operator*(const Interval<R>& x, const IntervalScalar<R>& c) {return x * Interval<R>(c);}
+template<class R> Interval<R> operator*(const IntervalScalar<R>& c, const Interval<R>& x) {return Interval<R>(c) * x;}
+template<class R> Interval<R> operator/(const Interval<R>& x, const IntervalScalar<R>& c) {return x / Interval<R>(c);}
+template<class R> Interval<R> operator/(const IntervalScalar<R>& c, const Interval<R>& x) {return Interval<R>(c) / x;}
+
+template<class R> Interval<R>& operator+=(Interval<R>& x, const Interval<R>& y) {return x = x + y;}
+template<class R> Interval<R>& operator-=(Interval<R>& x, const Interval<R>& y) {return x = x - y;}
+template<class R> Interval<R>& operator*=(Interval<R>& x, const Interval<R>& y) {return x = x * y;}
+template<class R> Interval<R>& operator/=(Interval<R>& x, const Interval<R>& y) {return x = x / y;}
+
+// Elementary functions
+template<class R> Interval<R> exp(const Interval<R>& x) {return IntervalRounding::outward2(std::exp(x.lo), std::exp(x.hi));}
+template<class R> Interval<R> exp2(const Interval<R>& x) {return IntervalRounding::outward2(std::exp2(x.lo), std::exp2(x.hi));}
+template<class R> Interval<R> atan(const Interval<R>& x) {return IntervalRounding::outward2(std::atan(x.lo), std::atan(x.hi));}
+template<class R> Interval<R> sinh(const Interval<R>& x) {return IntervalRounding::outward2(std::sinh(x.lo), std::sinh(x.hi));}
+template<class R> Interval<R> tanh(const Interval<R>& x) {return IntervalRounding::outward2(std::tanh(x.lo), std::tanh(x.hi));}
+// Defined on the positive part of x
+template<class R> Interval<R> log(const Interval<R>& x)
+{
+	return IntervalRounding::outward2(x.lo > 0 ? std::log(x.lo) : -std::numeric_limits<R>::infinity(), std::log(x.hi));
+}
+template<class R> Interval<R> sqrt(const Interval<R>& x)
+{
+	return {x.lo > 0 ? IntervalRounding::down(std::sqrt(x.lo)) : R(0), IntervalRounding::up(std::sqrt(x.hi))};
+}
+template<class R> Interval<R> abs(const Interval<R>& x)
+{
+	if (x.lo >= 0)
+		return x;
+	if (x.hi <= 0)
+		return -x;
+	return {R(0), std::max(-x.lo, x.hi)};
+}
+template<class R> Interval<R> cosh(const Interval<R>& x)
+{
+	const Interval<R> ax = abs(x);
+	return IntervalRounding::outward2(std::cosh(ax.lo), std::cosh(ax.hi));
+}
+// Integer power, exact at 0
+template<class R> Interval<R> pow(const Interval<R>& x, int n)
+{
+	if (n == 0)
+		return Interval<R>(1);
+	if (n < 0)
+		return Interval<R>(1) / pow(x, -n);
+	const Interval<R> base = (n % 2 == 0) ? abs(x) : x;
+	Interval<R> p(1);
+	for (int k = 0; k < n; ++k)
+		p = p * base;
+	return (n % 2 == 0) ? Interval<R>(std::max(R(0), p.lo), p.hi) : p;
+}
+
+// Sine: the bounds at the extremes, 1 or -1 if a maximum or a minimum is
+// inside (the test is widened, so that an extremum is never missed)
+template<class R> Interval<R> sin(const Interval<R>& x)
+{
+	const R pi = std::acos(R(-1));
+	if (!(x.width() < 2 * pi))
+		return {R(-1), R(1)};
+	const R slack = 8 * std::numeric_limits<R>::epsilon() * std::max({R(1), std::abs(x.lo), std::abs(x.hi)});
+	// Extremum pi / 2 + k pi in the interval, a maximum for even k
+	auto hasExtremum = [&](const R& offset)
+	{
+		const R k = std::ceil((x.lo - slack - offset) / (2 * pi));
+		return offset + 2 * pi * k <= x.hi + slack;
+	};
+	R lo = std::min(std::sin(x.lo), std::sin(x.hi));
+	R hi = std::max(std::sin(x.lo), std::sin(x.hi));
+	Interval<R> y = IntervalRounding::outward2(lo, hi);
+	if (hasExtremum(pi / 2))
+		y.hi = R(1);
+	if (hasExtremum(-pi / 2))
+		y.lo = R(-1);
+	y.lo = std::max(y.lo, R(-1));
+	y.hi = std::min(y.hi, R(1));
+	return y;
+}
+template<class R> Interval<R> cos(const Interval<R>& x)
+{
+	const R pi = std::acos(R(-1));
+	const R slack = 8 * std::numeric_limits<R>::epsilon() * std::max({R(1), std::abs(x.lo), std::abs(x.hi)});
+	// cos(x) = sin(x + pi / 2), with the shift rounded outwards
+	return sin(Interval<R>(x.lo + pi / 2 - slack, x.hi + pi / 2 + slack));
+}
+
+#endif
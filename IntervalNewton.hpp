@@ -0,0 +1,337 @@
+#ifndef _INTERVAL_NEWTON_HPP_
+#define _INTERVAL_NEWTON_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <mutex>
+#include <vector>
+#include "classZeroFun.hpp"
+#include "Interval.hpp"
+#include "ThreadPool.hpp"
+
+// Operator used to contract the boxes and to prove the existence of a root
+enum class IntervalOperator
+{
+	Newton,  // N(X) = m - F(m) / F'(X)
+	Krawczyk // K(X) = m - y F(m) + (1 - y F'(X)) (X - m), y = 1 / mid F'(X)
+};
+
+// Enclosure of a root
+template<class Real>
+struct RootEnclosure
+{
+	Real lower;
+	Real upper;
+	// True if the enclosure provably contains exactly one root
+	bool verified;
+
+	Real mid() const {return lower + (upper - lower) / 2;}
+};
+
+/* * * * * * * * * * * * * * * * * * * * * * *
+ * All the roots in an interval, certified   *
+ * * * * * * * * * * * * * * * * * * * * * * */
+/*!
+ * Branch and prune on [a, b] with the interval extensions F of f and F' of
+ * f' (e.g. generic lambdas evaluated on Interval): every box X where 0 is
+ * not in F(X) contains no root and is dropped. Where 0 is not in F'(X), f
+ * is monotone on X and the Newton (or Krawczyk) operator N(X) contracts X
+ * to N(X) ∩ X; N(X) inside the interior of X proves that X contains
+ * exactly one root, which is then contracted below tol. The other boxes
+ * are bisected, those narrower than tol are kept as unverified enclosures
+ * (multiple roots, or roots at the extremes of a box).
+ * Unlike the methods with an interval, f need not change sign at a and b
+ * and no bracket is searched. The interval is split in pieces processed
+ * in parallel on the pool, the enclosures that touch at their boundaries
+ * are merged and checked again.
+ * solve() returns the smallest root, all of them are in roots(); fEvals
+ * and dfEvals count the evaluations of F and F', iterations the boxes.
+ */
+template<class Traits, class FI = typename Traits::IntervalFunType, class DFI = FI>
+class BasicIntervalNewton final : public BasicSolverBase<Traits>
+{
+public:
+	using typename BasicSolverBase<Traits>::Real;
+	using Box = Interval<Real>;
+	using Enclosure = RootEnclosure<Real>;
+
+	// Constructor, maxIt is the maximum number of contractions of a verified box
+	BasicIntervalNewton(const FI& fi_, const DFI& dfi_, const Real& a_, const Real& b_, const Real& tol_, const unsigned int& maxIt_ = 150, const IntervalOperator& op_ = IntervalOperator::Newton, ThreadPool& pool_ = ThreadPool::shared()) :
+		BasicSolverBase<Traits>(MidpointFunction{fi_}, tol_), fi(fi_), dfi(dfi_), a(a_), b(b_), maxIt(maxIt_), op(op_), pool(&pool_) {}
+
+	Real solve() override;
+	using BasicSolverBase<Traits>::solve;
+
+	// Changes all the parameters and the interval
+	void reset(const typename BasicSolverBase<Traits>::Parameters& params) override
+	{
+		a = params.a;
+		b = params.b;
+		maxIt = params.maxIt;
+		BasicSolverBase<Traits>::reset(params);
+	}
+
+	// Changes the interval
+	void setProblem(const typename BasicSolverBase<Traits>::Problem& problem) override
+	{
+		a = problem.a;
+		b = problem.b;
+	}
+
+	// Changes the maximum number of boxes processed by a solve
+	void setMaxBoxes(const std::size_t& maxBoxes_) {maxBoxes = maxBoxes_;}
+
+	// Changes the operator
+	void setOperator(const IntervalOperator& op_) {op = op_;}
+
+	// Enclosures of the roots found by the last solve, in increasing order
+	const std::vector<Enclosure>& roots() const {return enclosures;}
+
+	// Number of roots of the last solve proved to be in their enclosure
+	std::size_t verifiedRoots() const {return std::count_if(enclosures.begin(), enclosures.end(), [](const Enclosure& e) {return e.verified;});}
+
+protected:
+	using BasicSolverBase<Traits>::tol;
+
+	// Point function of the base, the midpoint of F on a point
+	struct MidpointFunction
+	{
+		FI fi;
+		Real operator()(const Real& x) const {return fi(Box(x)).mid();}
+	};
+
+	// Interval extensions of f and f'
+	FI fi;
+	DFI dfi;
+	// Interval of the search
+	Real a;
+	Real b;
+	// Maximum number of contractions of a verified box
+	unsigned int maxIt;
+	// Maximum number of boxes of a solve
+	std::size_t maxBoxes{1u << 20};
+	IntervalOperator op;
+	ThreadPool* pool;
+	// Enclosures of the last solve
+	std::vector<Enclosure> enclosures;
+
+	// Counters of a piece, summed at the end
+	struct Counters
+	{
+		std::size_t fEvals{0u};
+		std::size_t dfEvals{0u};
+	};
+
+	// A general point function cannot be used
+	void functionChanged() override
+	{
+		Logger::log(LogLevel::Warning, "IntervalNewton needs the interval extensions, build a new solver");
+	}
+
+	// Image of x by the operator, given F'(x); entire if it cannot be computed
+	Box contract(const Box& x, const Box& dfx, Counters& counters) const;
+
+	// True if x provably contains exactly one root, given F'(x) without 0
+	bool unique(const Box& x, const Box& n, Counters& counters) const;
+
+	// Roots in a piece of the interval, unprocessed boxes are added as unverified
+	void search(const Box& piece, std::vector<Enclosure>& found, Counters& counters, std::atomic<std::size_t>& boxes, std::atomic<bool>& exhausted) const;
+};
+
+template<class Traits, class FI, class DFI>
+auto BasicIntervalNewton<Traits, FI, DFI>::contract(const Box& x, const Box& dfx, Counters& counters) const -> Box
+{
+	const Real m = x.mid();
+	const Box fm = fi(Box(m));
+	++counters.fEvals;
+	if (op == IntervalOperator::Newton)
+		return Box(m) - fm / dfx;
+
+	// Krawczyk, y is a point approximation of 1 / f'
+	const Real y = 1 / dfx.mid();
+	return Box(m) - y * fm + (Box(1) - y * dfx) * (x - m);
+}
+
+// Existence and uniqueness of a root in x
+/*!
+ * f is monotone on x (0 is not in F'(x)), the root is unique if it exists:
+ * it exists if the image n of x by the operator is in the interior of x, or
+ * if f has strictly opposite signs at the extremes of x
+ */
+template<class Traits, class FI, class DFI>
+bool BasicIntervalNewton<Traits, FI, DFI>::unique(const Box& x, const Box& n, Counters& counters) const
+{
+	if (x.interiorContains(n))
+		return true;
+	const Box flo = fi(Box(x.lo));
+	const Box fhi = fi(Box(x.hi));
+	counters.fEvals += 2;
+	return (flo.hi < 0 && fhi.lo > 0) || (flo.lo > 0 && fhi.hi < 0);
+}
+
+// Branch and prune on a piece
+/*!
+ * Depth first, so that the stack of the boxes stays short: a box is
+ * dropped, contracted or bisected. The contraction of a box that is not
+ * verified is kept only if it halves its width at least, otherwise the
+ * box is bisected
+ */
+template<class Traits, class FI, class DFI>
+void BasicIntervalNewton<Traits, FI, DFI>::search(const Box& piece, std::vector<Enclosure>& found, Counters& counters, std::atomic<std::size_t>& boxes, std::atomic<bool>& exhausted) const
+{
+	std::vector<Box> stack{piece};
+	while (!stack.empty())
+	{
+		if (boxes.fetch_add(1) >= maxBoxes)
+		{
+			exhausted = true;
+			for (const Box& x : stack)
+				found.push_back({x.lo, x.hi, false});
+			return;
+		}
+		Box x = stack.back();
+		stack.pop_back();
+
+		// No root
+		const Box fx = fi(x);
+		++counters.fEvals;
+		if (!fx.contains(0))
+			continue;
+		if (x.width() <= tol)
+		{
+			found.push_back({x.lo, x.hi, false});
+			continue;
+		}
+
+		// f not monotone: bisect
+		const Box dfx = dfi(x);
+		++counters.dfEvals;
+		if (dfx.contains(0))
+		{
+			const Real m = x.mid();
+			stack.push_back({m, x.hi});
+			stack.push_back({x.lo, m});
+			continue;
+		}
+
+		Box n = contract(x, dfx, counters);
+		if (unique(x, n, counters))
+		{
+			// Contraction of the verified box, the root stays in it
+			for (unsigned int k = 0; k < maxIt && x.width() > tol; ++k)
+			{
+				const Box next = intersect(x, n);
+				if (next.empty() || !(next.width() < x.width()))
+					break;
+				x = next;
+				const Box d = dfi(x);
+				++counters.dfEvals;
+				n = contract(x, d, counters);
+			}
+			found.push_back({x.lo, x.hi, true});
+			continue;
+		}
+
+		const Box next = intersect(x, n);
+		if (next.empty())
+			continue;
+		if (next.width() <= x.width() / 2)
+			stack.push_back(next);
+		else
+		{
+			const Real m = next.mid();
+			stack.push_back({m, next.hi});
+			stack.push_back({next.lo, m});
+		}
+	}
+}
+
+// Interval Newton implementation
+/*!
+ * The pieces are four per worker of the pool; the enclosures of the pieces
+ * are sorted and those that overlap are merged, the merged one is
+ * verified if the operator proves it contains a single root
+ *
+ * @return The midpoint of the enclosure of the smallest root (NaN if there is none)
+ */
+template<class Traits, class FI, class DFI>
+auto BasicIntervalNewton<Traits, FI, DFI>::solve() -> Real
+{
+	enclosures.clear();
+	if (!(b > a))
+	{
+		Logger::log(LogLevel::Error, "ERROR, the interval is empty");
+		this->setStats(SolveStatus::InvalidInterval, 0u, std::numeric_limits<Real>::quiet_NaN());
+
+		return std::numeric_limits<Real>::quiet_NaN();
+	}
+
+	const std::size_t nPieces = 4 * static_cast<std::size_t>(pool->size());
+	const Real h = (b - a) / nPieces;
+	std::vector<std::vector<Enclosure>> found(nPieces);
+	std::vector<Counters> counters(nPieces);
+	std::atomic<std::size_t> boxes{0u};
+	std::atomic<bool> exhausted{false};
+	pool->parallelFor(nPieces, [&](std::size_t i)
+	{
+		const Box piece(a + i * h, (i + 1 == nPieces) ? b : a + (i + 1) * h);
+		search(piece, found[i], counters[i], boxes, exhausted);
+	}, 1);
+
+	Counters total;
+	for (std::size_t i = 0; i < nPieces; ++i)
+	{
+		enclosures.insert(enclosures.end(), found[i].begin(), found[i].end());
+		total.fEvals += counters[i].fEvals;
+		total.dfEvals += counters[i].dfEvals;
+	}
+	std::sort(enclosures.begin(), enclosures.end(), [](const Enclosure& x, const Enclosure& y) {return x.lower < y.lower;});
+
+	// Merge of the enclosures that overlap (the same root, or roots closer than tol)
+	std::size_t last = 0;
+	for (std::size_t k = 1; k < enclosures.size(); ++k)
+	{
+		Enclosure& e = enclosures[last];
+		if (enclosures[k].lower <= e.upper)
+		{
+			const Box x(e.lower, std::max(e.upper, enclosures[k].upper));
+			const Box dfx = dfi(x);
+			++total.dfEvals;
+			e = {x.lo, x.hi, !dfx.contains(0) && unique(x, contract(x, dfx, total), total)};
+		}
+		else
+			enclosures[++last] = enclosures[k];
+	}
+	if (!enclosures.empty())
+		enclosures.resize(last + 1);
+
+	this->stats.fEvals += total.fEvals;
+	this->stats.dfEvals += total.dfEvals;
+	const unsigned int iter = static_cast<unsigned int>(std::min<std::size_t>(boxes, std::numeric_limits<unsigned int>::max()));
+	if (enclosures.empty())
+	{
+		Logger::log(LogLevel::Error, "ERROR, the function has no zero in the interval");
+		this->setStats(SolveStatus::InvalidInterval, iter, std::numeric_limits<Real>::quiet_NaN(), b - a);
+
+		return std::numeric_limits<Real>::quiet_NaN();
+	}
+
+	const Enclosure& first = enclosures.front();
+	const Real zero = first.mid();
+	const Real residual = std::abs(this->evalF(zero));
+	if (exhausted)
+		Logger::log(LogLevel::Warning, "IntervalNewton: maximum number of boxes reached, some enclosures are not verified");
+	this->setStats((first.verified && !exhausted) ? SolveStatus::Converged : SolveStatus::MaxIterations, iter, residual, first.upper - first.lower);
+	return zero;
+}
+
+// Deduce FI and DFI from the arguments, the traits default to SolverTraits
+template<class FI, class DFI, class ... Args>
+BasicIntervalNewton(const FI&, const DFI&, const SolverTraits::Real&, const Args&...) -> BasicIntervalNewton<SolverTraits, FI, DFI>;
+
+using IntervalNewton = BasicIntervalNewton<SolverTraits>;
+
+#endif
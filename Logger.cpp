@@ -0,0 +1,43 @@
+#include "Logger.hpp"
+#include <iostream>
+#include <mutex>
+
+std::atomic<int> Logger::threshold{static_cast<int>(LogLevel::Off)};
+
+// Lock serializing the calls to the sink
+static std::mutex sinkMutex;
+
+// Installed sink
+static Logger::Sink& sinkInstance()
+{
+	static Logger::Sink sink;
+	return sink;
+}
+
+void Logger::setSink(Sink sink, LogLevel level)
+{
+	std::lock_guard<std::mutex> lock(sinkMutex);
+	const bool active = static_cast<bool>(sink);
+	sinkInstance() = std::move(sink);
+	threshold = static_cast<int>(active ? level : LogLevel::Off);
+}
+
+void Logger::setLevel(LogLevel level)
+{
+	std::lock_guard<std::mutex> lock(sinkMutex);
+	if (sinkInstance())
+		threshold = static_cast<int>(level);
+}
+
+void Logger::consoleSink(LogLevel level, const std::string& message)
+{
+	static const char* names[] = {"DEBUG", "INFO", "WARNING", "ERROR"};
+	std::cerr << "[" << names[static_cast<int>(level)] << "] " << message << '\n';
+}
+
+void Logger::write(LogLevel level, const std::string& message)
+{
+	std::lock_guard<std::mutex> lock(sinkMutex);
+	if (sinkInstance())
+		sinkInstance()(level, message);
+}
@@ -0,0 +1,61 @@
+#ifndef _LOGGER_HPP_
+#define _LOGGER_HPP_
+
+#include <atomic>
+#include <functional>
+#include <sstream>
+#include <string>
+
+// Severity of a message
+enum class LogLevel : int {Debug, Info, Warning, Error, Off};
+
+/* * * * * * * * * * * * * * * * *
+ * Pluggable, level-filtered log *
+ * * * * * * * * * * * * * * * * */
+/*!
+ * The solvers report what they do through Logger::log. By default there is
+ * no sink and the level is Off, so a call costs a load and a branch and the
+ * message is not even formatted. A sink receives only the messages with
+ * level at least the one given to setSink; the calls to the sink are
+ * serialized. Set the sink before starting the solves.
+ */
+class Logger
+{
+public:
+	using Sink = std::function<void(LogLevel, const std::string&)>;
+
+	// Installs a sink for the messages with at least the given level (an empty sink disables the log)
+	static void setSink(Sink sink, LogLevel level = LogLevel::Info);
+
+	// Changes the minimum level of the messages passed to the sink
+	static void setLevel(LogLevel level);
+
+	// True if a message with the given level would be passed to the sink
+	static bool enabled(LogLevel level)
+	{
+		return static_cast<int>(level) >= threshold.load(std::memory_order_relaxed);
+	}
+
+	// Formats the arguments as with operator<< and passes the message to the sink
+	template<class ... Args>
+	static void log(LogLevel level, const Args&... args)
+	{
+		if (!enabled(level))
+			return;
+		std::ostringstream message;
+		(message << ... << args);
+		write(level, message.str());
+	}
+
+	// Sink printing the messages on std::cerr
+	static void consoleSink(LogLevel level, const std::string& message);
+
+private:
+	// Minimum level passed to the sink
+	static std::atomic<int> threshold;
+
+	// Passes the message to the sink
+	static void write(LogLevel level, const std::string& message);
+};
+
+#endif
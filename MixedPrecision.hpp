@@ -0,0 +1,132 @@
+#ifndef _MIXED_PRECISION_HPP_
+#define _MIXED_PRECISION_HPP_
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <string>
+#include "classZeroFun.hpp"
+#include "SolverFactory.hpp"
+
+/* * * * * * * * * * * * * * * * * * * * * * *
+ * Mixed precision: coarse solve, refinement *
+ * * * * * * * * * * * * * * * * * * * * * * */
+/*!
+ * Solves first with any solver in the precision of CoarseTraits (float by
+ * default, cheaper and with twice the SIMD lanes), then refines the zero
+ * with the Brent method in the precision of Traits on a small bracket
+ * around it, expanded with the golden-section search if the coarse zero is
+ * not accurate enough. The statistics add the evaluations of both solves.
+ */
+template<class Traits, class CoarseTraits = FloatSolverTraits>
+class BasicMixedPrecision final : public BasicSolverBase<Traits>
+{
+public:
+	using typename BasicSolverBase<Traits>::Real;
+	using CoarseReal = typename CoarseTraits::Real;
+
+	// Constructor, coarseTol is the tolerance of the coarse solver
+	BasicMixedPrecision(std::unique_ptr<BasicSolverBase<CoarseTraits>> coarse_, const typename Traits::FunType& f_, const Real& coarseTol_, const Real& tol_, const unsigned int& maxIt_) :
+		BasicSolverBase<Traits>(f_, tol_), coarse(std::move(coarse_)), coarseTol(coarseTol_), maxIt(maxIt_) {}
+
+	Real solve() override;
+	using BasicSolverBase<Traits>::solve;
+
+	// Changes all the parameters, also of the coarse solver
+	void reset(const typename BasicSolverBase<Traits>::Parameters& p) override
+	{
+		maxIt = p.maxIt;
+		coarse->reset(convertParameters<CoarseTraits>(p));
+		BasicSolverBase<Traits>::reset(p);
+	}
+
+	// Changes the problem of the coarse solver
+	void setProblem(const typename BasicSolverBase<Traits>::Problem& problem) override
+	{
+		coarse->setProblem({static_cast<CoarseReal>(problem.a), static_cast<CoarseReal>(problem.b), static_cast<CoarseReal>(problem.x0)});
+	}
+
+	// Statistics of the coarse part of the last solve
+	const BasicSolveStats<CoarseTraits>& coarseStats() const {return coarseResult;}
+
+private:
+	using BasicSolverBase<Traits>::f;
+	using BasicSolverBase<Traits>::tol;
+
+	std::unique_ptr<BasicSolverBase<CoarseTraits>> coarse;
+	// Refinement, built by the first solve
+	std::unique_ptr<BasicBrent<Traits>> fine;
+	Real coarseTol;
+	unsigned int maxIt;
+	BasicSolveStats<CoarseTraits> coarseResult;
+
+	// The coarse solver keeps its own function
+	void functionChanged() override
+	{
+		Logger::log(LogLevel::Warning, "MixedPrecision changes only the function of the refinement");
+	}
+};
+
+// Mixed precision solver implementation
+/*!
+ * @return The approximation of the zero
+ */
+template<class Traits, class CoarseTraits>
+auto BasicMixedPrecision<Traits, CoarseTraits>::solve() -> Real
+{
+	coarseResult = coarse->solveWithStats();
+	this->stats.fEvals += coarseResult.fEvals;
+	this->stats.dfEvals += coarseResult.dfEvals;
+	if (!coarseResult.ok())
+	{
+		Logger::log(LogLevel::Error, "ERROR, the coarse solve failed");
+		this->setStats(coarseResult.status, coarseResult.iterations, static_cast<Real>(coarseResult.residual));
+
+		return std::numeric_limits<Real>::quiet_NaN();
+	}
+
+	// The coarse zero is accurate to its tolerance and to the rounding of CoarseReal
+	const Real z = static_cast<Real>(coarseResult.zero);
+	const Real w = 2 * coarseTol * std::max(Real(1), std::abs(z)) + 8 * std::numeric_limits<CoarseReal>::epsilon() * std::abs(z);
+	if (!fine)
+		fine = std::make_unique<BasicBrent<Traits>>(f, z - w, z + w, tol, maxIt, w, 50, BracketStrategy::Golden);
+	else
+	{
+		fine->setBracketStep(w);
+		fine->setInterval(z - w, z + w);
+	}
+	// The policy applies to the refinement
+	fine->setStoppingPolicy(this->policy);
+	const BasicSolveStats<Traits> result = fine->solveWithStats();
+
+	this->stats.fEvals += result.fEvals;
+	this->stats.dfEvals += result.dfEvals;
+	this->setStats(result.status, coarseResult.iterations + result.iterations, result.residual, result.bracketWidth);
+	return result.zero;
+}
+
+// Mixed precision solver for the method chosen by name, nullptr as make_solver
+/*!
+ * The coarse solver uses the functions coarseFs and the parameters p, with
+ * the tolerances raised to what CoarseReal can reach; the refinement uses
+ * fs.f (the polynomial for the Polynomial method) and the tolerance of p
+ */
+template<class Traits, class CoarseTraits = FloatSolverTraits>
+std::unique_ptr<BasicSolverBase<Traits>> make_mixed_precision_solver(const std::string& method, const BasicSolverFunctions<CoarseTraits>& coarseFs, const BasicSolverFunctions<Traits>& fs, const BasicSolverParameters<Traits>& p)
+{
+	using CoarseReal = typename CoarseTraits::Real;
+	BasicSolverParameters<CoarseTraits> q = convertParameters<CoarseTraits>(p);
+	q.tol = std::max(q.tol, 64 * std::numeric_limits<CoarseReal>::epsilon());
+	q.tola = std::max(q.tola, 64 * std::numeric_limits<CoarseReal>::epsilon());
+
+	std::unique_ptr<BasicSolverBase<CoarseTraits>> coarse = BasicSolverFactory<CoarseTraits>().make_solver(method, coarseFs, q);
+	if (!coarse)
+		return nullptr;
+	const typename Traits::FunType f = (method == "Polynomial") ? typename Traits::FunType(BasicPolynomial<Traits>(fs.coefficients)) : fs.f;
+	return std::make_unique<BasicMixedPrecision<Traits, CoarseTraits>>(std::move(coarse), f, static_cast<typename Traits::Real>(q.tol), p.tol, p.maxIt);
+}
+
+using MixedPrecision = BasicMixedPrecision<SolverTraits>;
+
+#endif
@@ -0,0 +1,340 @@
+#ifndef _NEWTON_SYSTEM_HPP_
+#define _NEWTON_SYSTEM_HPP_
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <type_traits>
+#include "SolveStats.hpp"
+#include "Logger.hpp"
+
+/*
+ * Newton methods for small systems f(x) = 0, f: R^N -> R^N, with the size
+ * fixed at compile time: vectors and matrices are std::arrays, so a solve
+ * does not allocate.
+ */
+
+template<class Real, std::size_t N>
+using SystemVector = std::array<Real, N>;
+
+// Matrix stored by rows
+template<class Real, std::size_t N>
+using SystemMatrix = std::array<std::array<Real, N>, N>;
+
+/* * * * * * * * * * * * * * * * * * * * * *
+ * LU factorization with partial pivoting  *
+ * * * * * * * * * * * * * * * * * * * * * */
+template<class Real, std::size_t N>
+class LUFactorization
+{
+public:
+	// Factorizes A, false if it is singular
+	bool factor(const SystemMatrix<Real, N>& A);
+
+	// Solution of A x = b with the last factorized A
+	SystemVector<Real, N> solve(SystemVector<Real, N> b) const;
+
+private:
+	// L (unit diagonal, below) and U (on and above the diagonal)
+	SystemMatrix<Real, N> lu;
+	// Row swapped with row k at step k
+	std::array<std::size_t, N> pivot;
+};
+
+template<class Real, std::size_t N>
+bool LUFactorization<Real, N>::factor(const SystemMatrix<Real, N>& A)
+{
+	lu = A;
+	for (std::size_t k = 0; k < N; ++k)
+	{
+		std::size_t p = k;
+		for (std::size_t i = k + 1; i < N; ++i)
+			if (std::abs(lu[i][k]) > std::abs(lu[p][k]))
+				p = i;
+		pivot[k] = p;
+		if (lu[p][k] == 0. || !std::isfinite(lu[p][k]))
+			return false;
+		std::swap(lu[k], lu[p]);
+		for (std::size_t i = k + 1; i < N; ++i)
+		{
+			lu[i][k] /= lu[k][k];
+			for (std::size_t j = k + 1; j < N; ++j)
+				lu[i][j] -= lu[i][k] * lu[k][j];
+		}
+	}
+	return true;
+}
+
+template<class Real, std::size_t N>
+SystemVector<Real, N> LUFactorization<Real, N>::solve(SystemVector<Real, N> b) const
+{
+	for (std::size_t k = 0; k < N; ++k)
+		std::swap(b[k], b[pivot[k]]);
+	for (std::size_t i = 1; i < N; ++i)
+		for (std::size_t j = 0; j < i; ++j)
+			b[i] -= lu[i][j] * b[j];
+	for (std::size_t i = N; i-- > 0;)
+	{
+		for (std::size_t j = i + 1; j < N; ++j)
+			b[i] -= lu[i][j] * b[j];
+		b[i] /= lu[i][i];
+	}
+	return b;
+}
+
+// Forward difference approximation of the Jacobian of f, for when it is not known
+template<class Traits, std::size_t N, class F>
+struct ForwardDifferenceJacobian
+{
+	using Real = typename Traits::Real;
+
+	// Evaluations of f per Jacobian, counted in fEvals by BasicNewtonSystem
+	static constexpr std::size_t fEvals = N + 1;
+
+	SystemMatrix<Real, N> operator()(const SystemVector<Real, N>& x) const
+	{
+		SystemMatrix<Real, N> J;
+		const SystemVector<Real, N> y = f(x);
+		for (std::size_t j = 0; j < N; ++j)
+		{
+			SystemVector<Real, N> xh = x;
+			const Real step = h * std::max(Real(1), std::abs(x[j]));
+			xh[j] += step;
+			const SystemVector<Real, N> yh = f(xh);
+			for (std::size_t i = 0; i < N; ++i)
+				J[i][j] = (yh[i] - y[i]) / step;
+		}
+		return J;
+	}
+
+	F f;
+	Real h;
+};
+
+// Evaluations of f made by one evaluation of a Jacobian of type J: J::fEvals if it is given, 0 otherwise
+template<class J, class = void>
+struct JacobianFEvals : std::integral_constant<std::size_t, 0> {};
+
+template<class J>
+struct JacobianFEvals<J, std::void_t<decltype(J::fEvals)>> : std::integral_constant<std::size_t, J::fEvals> {};
+
+// How the Jacobian is updated between the iterations
+enum class JacobianUpdate
+{
+	Newton,  // evaluated and factorized every refresh iterations (every one for Newton)
+	Broyden  // evaluated once, then corrected with rank-1 updates of its inverse
+};
+
+// Statistics of a solve of a system
+template<class Traits, std::size_t N>
+struct BasicSystemSolveStats
+{
+	using Real = typename Traits::Real;
+
+	// Approximation of the zero (NaN if not found)
+	SystemVector<Real, N> zero;
+	// Outcome of the solve
+	SolveStatus status{SolveStatus::NotSolved};
+	// Number of evaluations of f, with those of a ForwardDifferenceJacobian
+	std::size_t fEvals{0u};
+	// Number of evaluations of the Jacobian
+	std::size_t jacobianEvals{0u};
+	// Number of LU factorizations
+	std::size_t factorizations{0u};
+	// Number of iterations
+	unsigned int iterations{0u};
+	// Maximum norm of f at the last iterate
+	Real residual = std::numeric_limits<Real>::quiet_NaN();
+
+	bool ok() const {return status == SolveStatus::Converged;}
+};
+
+/* * * * * * * * * * * * * * * * * * * *
+ * Newton method for systems (size N)  *
+ * * * * * * * * * * * * * * * * * * * */
+/*!
+ * With JacobianUpdate::Newton the Jacobian is evaluated and factorized
+ * every refresh iterations and the factorization is reused in between;
+ * refresh = 1 is the Newton method, larger values the Shamanskii method,
+ * refresh = 0 the chord method (only the Jacobian at x0).
+ * With JacobianUpdate::Broyden the inverse of the Jacobian at x0 is
+ * corrected at every iteration by the rank-1 update of the good Broyden
+ * method, the Jacobian is evaluated again only if the update breaks down.
+ * Stops when the maximum norm of f is below tol times the one at x0 plus
+ * tola, as Newton.
+ */
+template<class Traits, std::size_t N, class F = std::function<SystemVector<typename Traits::Real, N>(const SystemVector<typename Traits::Real, N>&)>, class J = std::function<SystemMatrix<typename Traits::Real, N>(const SystemVector<typename Traits::Real, N>&)>>
+class BasicNewtonSystem
+{
+public:
+	using Real = typename Traits::Real;
+	using Vector = SystemVector<Real, N>;
+	using Matrix = SystemMatrix<Real, N>;
+
+	// Constructor
+	BasicNewtonSystem(const F& f_, const J& jac_, const Vector& x0_, const Real& tol_, const Real& tola_, const unsigned int& maxIt_, const JacobianUpdate& update_ = JacobianUpdate::Newton, const unsigned int& refresh_ = 1) :
+		f(f_), jac(jac_), x0(x0_), tol(tol_), tola(tola_), maxIt(maxIt_), update(update_), refresh(refresh_) {}
+
+	// Solves starting from x0 (the object can be solved again)
+	Vector solve() {return solveWithStats().zero;}
+
+	// Solves and returns the zero together with the statistics of the solve
+	BasicSystemSolveStats<Traits, N> solveWithStats();
+
+	// Changes the starting point
+	void setStart(const Vector& x0_) {x0 = x0_;}
+
+	// Outcome of the last solve
+	SolveStatus status() const {return lastStatus;}
+
+private:
+	F f;
+	J jac;
+	Vector x0;
+	Real tol;
+	Real tola;
+	unsigned int maxIt;
+	JacobianUpdate update;
+	unsigned int refresh;
+	SolveStatus lastStatus{SolveStatus::NotSolved};
+
+	static Real norm(const Vector& v)
+	{
+		Real m{0.};
+		for (const Real& vi : v)
+			m = std::max(m, std::abs(vi));
+		return std::isfinite(m) ? m : std::numeric_limits<Real>::infinity();
+	}
+};
+
+// Newton method for systems implementation
+/*!
+ * @return the zero and the statistics of the solve
+ */
+template<class Traits, std::size_t N, class F, class J>
+auto BasicNewtonSystem<Traits, N, F, J>::solveWithStats() -> BasicSystemSolveStats<Traits, N>
+{
+	BasicSystemSolveStats<Traits, N> stats;
+	Vector x = x0;
+	Vector y = f(x);
+	++stats.fEvals;
+	Real resid = norm(y);
+	const Real check = tol * resid + tola;
+
+	LUFactorization<Real, N> lu;
+	// Inverse of the Jacobian, for Broyden
+	Matrix H;
+	// Iterations since the last factorization, none at the start
+	unsigned int age = refresh;
+	bool fresh = true;
+	bool singular = false;
+
+	// Evaluates and factorizes the Jacobian at x, for Broyden also its inverse
+	auto factorize = [&]()
+	{
+		++stats.jacobianEvals;
+		stats.fEvals += JacobianFEvals<J>::value;
+		++stats.factorizations;
+		age = 0;
+		if (!lu.factor(jac(x)))
+			return false;
+		if (update == JacobianUpdate::Broyden)
+			for (std::size_t j = 0; j < N; ++j)
+			{
+				Vector e{};
+				e[j] = 1.;
+				const Vector col = lu.solve(e);
+				for (std::size_t i = 0; i < N; ++i)
+					H[i][j] = col[i];
+			}
+		return true;
+	};
+
+	unsigned int iter{0u};
+	while (resid > check && iter < maxIt)
+	{
+		++iter;
+		const bool refactor = (update == JacobianUpdate::Newton) ? (fresh || (refresh > 0 && age >= refresh)) : fresh;
+		if (refactor && !(singular = !factorize()))
+			fresh = false;
+		if (singular)
+			break;
+
+		// Step
+		Vector s;
+		if (update == JacobianUpdate::Broyden)
+			for (std::size_t i = 0; i < N; ++i)
+			{
+				s[i] = 0.;
+				for (std::size_t j = 0; j < N; ++j)
+					s[i] -= H[i][j] * y[j];
+			}
+		else
+		{
+			s = lu.solve(y);
+			for (Real& si : s)
+				si = -si;
+		}
+		for (std::size_t i = 0; i < N; ++i)
+			x[i] += s[i];
+		const Vector yNew = f(x);
+		++stats.fEvals;
+		++age;
+
+		if (update == JacobianUpdate::Broyden)
+		{
+			// H += (s - H dy) s^T H / (s^T H dy)
+			Vector dy, Hdy, sH;
+			for (std::size_t i = 0; i < N; ++i)
+				dy[i] = yNew[i] - y[i];
+			Real den{0.};
+			for (std::size_t i = 0; i < N; ++i)
+			{
+				Hdy[i] = 0.;
+				sH[i] = 0.;
+				for (std::size_t j = 0; j < N; ++j)
+				{
+					Hdy[i] += H[i][j] * dy[j];
+					sH[i] += s[j] * H[j][i];
+				}
+			}
+			for (std::size_t i = 0; i < N; ++i)
+				den += s[i] * Hdy[i];
+			if (std::abs(den) > std::numeric_limits<Real>::epsilon() * norm(s) * norm(Hdy))
+				for (std::size_t i = 0; i < N; ++i)
+					for (std::size_t j = 0; j < N; ++j)
+						H[i][j] += (s[i] - Hdy[i]) * sH[j] / den;
+			else
+				// The update breaks down, start again from the Jacobian
+				fresh = true;
+		}
+		y = yNew;
+		resid = norm(y);
+	}
+
+	stats.iterations = iter;
+	stats.residual = resid;
+	stats.status = singular ? SolveStatus::Diverged : !std::isfinite(resid) ? SolveStatus::Diverged : resid <= check ? SolveStatus::Converged : SolveStatus::MaxIterations;
+	lastStatus = stats.status;
+	if (stats.ok())
+		stats.zero = x;
+	else
+	{
+		Logger::log(LogLevel::Error, singular ? "ERROR, singular Jacobian" : "ERROR, could not find the zero");
+		stats.zero.fill(std::numeric_limits<Real>::quiet_NaN());
+	}
+	return stats;
+}
+
+template<std::size_t N>
+using NewtonSystem = BasicNewtonSystem<SolverTraits, N>;
+
+// With the ForwardDifferenceJacobian of f, whose evaluations are counted in
+// fEvals (behind a std::function, as in NewtonSystem, they are not)
+template<std::size_t N, class F>
+using ForwardDifferenceNewtonSystem = BasicNewtonSystem<SolverTraits, N, F, ForwardDifferenceJacobian<SolverTraits, N, F>>;
+
+#endif
@@ -0,0 +1,114 @@
+#ifndef _PARALLEL_SOLVE_DRIVER_HPP_
+#define _PARALLEL_SOLVE_DRIVER_HPP_
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "classZeroFun.hpp"
+#include "DeviceBatchSolver.hpp"
+#include "SolverBatch.hpp"
+#include "SolverFactory.hpp"
+#include "ThreadPool.hpp"
+
+// Solves many independent problems on a pool of threads
+class ParallelSolveDriver
+{
+public:
+	using T = SolverTraits;
+
+	explicit ParallelSolveDriver(unsigned int nThreads = std::thread::hardware_concurrency()) : pool(nThreads) {}
+
+	// Solves every problem, the results are in the same order of the solvers (NaN if not found)
+	std::vector<T::Real> solve(const std::vector<std::unique_ptr<SolverBase>>& solvers)
+	{
+		std::vector<T::Real> zeros(solvers.size());
+		// Automatic chunks: the work stealing balances solves of very different cost
+		pool.parallelFor(solvers.size(), [&solvers, &zeros](std::size_t i) {zeros[i] = solvers[i]->solve();});
+		return zeros;
+	}
+
+	// Solves every problem, the statistics are in the same order of the solvers
+	std::vector<SolveStats> solveWithStats(const std::vector<std::unique_ptr<SolverBase>>& solvers)
+	{
+		std::vector<SolveStats> stats(solvers.size());
+		pool.parallelFor(solvers.size(), [&solvers, &stats](std::size_t i) {stats[i] = solvers[i]->solveWithStats();});
+		return stats;
+	}
+
+	// Solves the problems of the batch with the method, the other parameters are those of p
+	/*!
+	 * The batch is split in chunks, one solver of the method is built per
+	 * chunk and reset for each of its problems, so that nothing is
+	 * allocated per problem
+	 *
+	 * @return false if the method does not exist or needs a function not given
+	 */
+	bool solve(const std::string& method, const SolverFunctions& fs, const SolverParameters& p, const ProblemBatch& problems, ResultBatch& results)
+	{
+		const std::size_t n = problems.size();
+		results.resize(n);
+		if (n == 0)
+			return SolverFactory::hasMethod(method);
+		const std::size_t grain = std::max<std::size_t>(1, n / (8 * pool.size()));
+		const std::size_t nChunks = (n + grain - 1) / grain;
+		std::vector<char> valid(nChunks, 1);
+		pool.parallelFor(nChunks, [&](std::size_t c)
+		{
+			SolverFactory::Solver solver;
+			SolverParameters q = p;
+			for (std::size_t i = c * grain; i < std::min(n, (c + 1) * grain); ++i)
+			{
+				q.a = problems.a()[i];
+				q.b = problems.b()[i];
+				q.x0 = problems.x0()[i];
+				q.tol = problems.tol()[i];
+				if (solver)
+					solver->reset(q);
+				else if (!(solver = SolverFactory().make_solver(method, fs, q)))
+				{
+					valid[c] = 0;
+					return;
+				}
+				results.store(i, solver->solveWithStats());
+			}
+		}, 1);
+		return std::all_of(valid.begin(), valid.end(), [](char v) {return v != 0;});
+	}
+
+	// Solves the problems of the batch with the kernels of DeviceBatchSolver on the backend
+	/*!
+	 * f and df are called as f(x, i) and must be callable on the device for
+	 * the GPU backend, the CPU one runs on the pool of the driver; only the
+	 * columns of the batch change from a problem to another, tola and maxIt
+	 * are those of p
+	 *
+	 * @return false if the method is not one of the kernels (hasDeviceMethod)
+	 */
+	template<class Kernel, class DKernel>
+	bool solve(const BatchBackend& backend, const std::string& method, const Kernel& f, const DKernel& df, const SolverParameters& p, const ProblemBatch& problems, ResultBatch& results)
+	{
+		const DeviceBatchSolver device(p.tol, p.tola, p.maxIt, backend, pool);
+		if (method == "Bisection")
+			device.bisection(f, problems, results);
+		else if (method == "Brent")
+			device.brent(f, problems, results);
+		else if (method == "Newton")
+			device.newton(f, df, problems, results);
+		else
+			return false;
+		return true;
+	}
+
+	// True if the method has a kernel in DeviceBatchSolver
+	static bool hasDeviceMethod(const std::string& method) {return method == "Bisection" || method == "Brent" || method == "Newton";}
+
+	// Pool used by the driver, can be shared with other parallel algorithms
+	ThreadPool& threadPool() {return pool;}
+
+private:
+	ThreadPool pool;
+};
+
+#endif
@@ -0,0 +1,361 @@
+#ifndef _POLYNOMIAL_SOLVER_HPP_
+#define _POLYNOMIAL_SOLVER_HPP_
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <limits>
+#include <vector>
+#include "classZeroFun.hpp"
+
+/* * * * * * * * * * * * * * * * *
+ * Polynomial, Horner evaluation *
+ * * * * * * * * * * * * * * * * */
+/*!
+ * p(x) = c[0] + c[1] x + ... + c[n] x^n, the coefficients are given from
+ * the lowest degree and the null leading ones are removed. It can be used
+ * as the function of any solver, also on dual numbers (AutoDiffNewton).
+ */
+template<class Traits>
+class BasicPolynomial
+{
+public:
+	using Real = typename Traits::Real;
+
+	explicit BasicPolynomial(std::vector<Real> c_) : c(std::move(c_))
+	{
+		while (c.size() > 1 && c.back() == 0.)
+			c.pop_back();
+		if (c.empty())
+			c.push_back(0.);
+	}
+
+	// Value at x, for real, complex and dual x
+	template<class X>
+	X operator()(const X& x) const
+	{
+		X p(c.back());
+		for (std::size_t k = c.size() - 1; k-- > 0;)
+			p = p * x + c[k];
+		return p;
+	}
+
+	// Value and derivative at x in one pass
+	Dual<Real> valueAndDerivative(const Real& x) const
+	{
+		Real p = c.back();
+		Real dp{0.};
+		for (std::size_t k = c.size() - 1; k-- > 0;)
+		{
+			dp = dp * x + p;
+			p = p * x + c[k];
+		}
+		return {p, dp};
+	}
+
+	// Values and derivatives at n points, dy may be null
+	void evaluate(const Real* x, Real* y, Real* dy, std::size_t n) const;
+
+	// Degree
+	std::size_t degree() const {return c.size() - 1;}
+
+	// Coefficients, from the lowest degree
+	const std::vector<Real>& coefficients() const {return c;}
+
+private:
+	std::vector<Real> c;
+};
+
+// Evaluation at many points
+/*!
+ * The points are processed in blocks, with the loop over the coefficients
+ * outside and the loop over the points of the block inside, so that the
+ * latter is vectorized (compile with -O3 -march=native)
+ */
+template<class Traits>
+void BasicPolynomial<Traits>::evaluate(const Real* x, Real* y, Real* dy, std::size_t n) const
+{
+	constexpr std::size_t block = 64;
+	Real p[block];
+	Real dp[block];
+	for (std::size_t start = 0; start < n; start += block)
+	{
+		const std::size_t m = std::min(block, n - start);
+		const Real* xs = x + start;
+		for (std::size_t i = 0; i < m; ++i)
+		{
+			p[i] = c.back();
+			dp[i] = 0.;
+		}
+		for (std::size_t k = c.size() - 1; k-- > 0;)
+			for (std::size_t i = 0; i < m; ++i)
+			{
+				dp[i] = dp[i] * xs[i] + p[i];
+				p[i] = p[i] * xs[i] + c[k];
+			}
+		std::copy(p, p + m, y + start);
+		if (dy)
+			std::copy(dp, dp + m, dy + start);
+	}
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * *
+ * All the roots of a polynomial (Aberth)    *
+ * * * * * * * * * * * * * * * * * * * * * * */
+/*!
+ * Finds all the complex roots at once with the Aberth-Ehrlich method,
+ * which converges cubically for simple roots, starting from points on
+ * circles fitted to the moduli of the roots. Each sweep costs one complex
+ * Horner pass (p and p') per root not converged yet, counted in fEvals and
+ * dfEvals.
+ * solve() returns the smallest real root in [a, b]; all the roots are in
+ * roots() and the real ones, polished with Newton, in realRoots().
+ */
+template<class Traits>
+class BasicPolynomialSolver final : public BasicSolverBase<Traits>
+{
+public:
+	using typename BasicSolverBase<Traits>::Real;
+	using Complex = std::complex<Real>;
+
+	// Constructor, [a, b] is the interval of the root returned by solve
+	BasicPolynomialSolver(const BasicPolynomial<Traits>& p_, const Real& a_, const Real& b_, const Real& tol_, const unsigned int& maxIt_) :
+		BasicSolverBase<Traits>(p_, tol_), p(p_), a(a_), b(b_), maxIt(maxIt_) {}
+
+	Real solve() override;
+	using BasicSolverBase<Traits>::solve;
+
+	// Changes the polynomial
+	void setPolynomial(const BasicPolynomial<Traits>& p_)
+	{
+		p = p_;
+		this->f = p_;
+	}
+
+	// Changes all the parameters and the interval
+	void reset(const typename BasicSolverBase<Traits>::Parameters& params) override
+	{
+		a = params.a;
+		b = params.b;
+		maxIt = params.maxIt;
+		BasicSolverBase<Traits>::reset(params);
+	}
+
+	// Changes the interval
+	void setProblem(const typename BasicSolverBase<Traits>::Problem& problem) override
+	{
+		a = problem.a;
+		b = problem.b;
+	}
+
+	// All the roots found by the last solve
+	const std::vector<Complex>& roots() const {return z;}
+
+	// The real roots found by the last solve, in increasing order
+	const std::vector<Real>& realRoots() const {return real;}
+
+protected:
+	using BasicSolverBase<Traits>::tol;
+
+	// Polynomial
+	BasicPolynomial<Traits> p;
+	// Interval of the root returned by solve
+	Real a;
+	Real b;
+	// Maximum number of sweeps
+	unsigned int maxIt;
+	// Roots of the last solve
+	std::vector<Complex> z;
+	std::vector<Real> real;
+
+	// A general function cannot be used
+	void functionChanged() override
+	{
+		Logger::log(LogLevel::Warning, "PolynomialSolver needs the coefficients, use setPolynomial");
+	}
+
+	// Aberth-Ehrlich iterations, true if all the roots converged, iter is the number of sweeps
+	bool aberth(unsigned int& iter);
+};
+
+// Aberth-Ehrlich iterations
+/*!
+ * The roots in 0 are removed first. The others are updated in place one
+ * after the other (Gauss-Seidel), a root stops being updated when its
+ * correction is below tol times its modulus, or when p at it is below the
+ * rounding error of the evaluation (ill-conditioned and multiple roots)
+ *
+ * @param iter the number of sweeps
+ * @return true if all the roots converged
+ */
+template<class Traits>
+bool BasicPolynomialSolver<Traits>::aberth(unsigned int& iter)
+{
+	const std::vector<Real>& coefficients = p.coefficients();
+	// Roots in 0, p(x) = x^m q(x)
+	std::size_t m{0};
+	while (coefficients[m] == 0.)
+		++m;
+	z.assign(m, Complex(0.));
+	const Real* c = coefficients.data() + m;
+	const std::size_t n = p.degree() - m;
+	iter = 0u;
+	if (n == 0)
+		return true;
+
+	// Starting points on circles given by the upper convex hull of the
+	// points (k, log|c[k]|) (Bini): an edge from i to j gives j - i points
+	// on the circle of radius (|c[i]| / |c[j]|)^(1 / (j - i))
+	std::vector<std::size_t> hull;
+	for (std::size_t k = 0; k <= n; ++k)
+	{
+		if (c[k] == 0.)
+			continue;
+		while (hull.size() >= 2)
+		{
+			const std::size_t i = hull[hull.size() - 2];
+			const std::size_t j = hull.back();
+			// Remove j if it is below the segment from i to k
+			if ((std::log(std::abs(c[j])) - std::log(std::abs(c[i]))) * (k - i) <= (std::log(std::abs(c[k])) - std::log(std::abs(c[i]))) * (j - i))
+				hull.pop_back();
+			else
+				break;
+		}
+		hull.push_back(k);
+	}
+	// The offset of the angle avoids starting on the real axis
+	const Real pi = std::acos(Real(-1));
+	std::vector<Complex> r;
+	r.reserve(n);
+	for (std::size_t e = 1; e < hull.size(); ++e)
+	{
+		const std::size_t i = hull[e - 1];
+		const std::size_t j = hull[e];
+		const Real radius = std::pow(std::abs(c[i] / c[j]), Real(1) / (j - i));
+		for (std::size_t k = 0; k < j - i; ++k)
+			r.push_back(std::polar(radius, 2 * pi * k / (j - i) + 2 * pi * i / n + Real(0.4)));
+	}
+
+	std::vector<char> done(n, 0);
+	std::size_t left{n};
+	while (left > 0 && iter < maxIt)
+	{
+		++iter;
+		for (std::size_t k = 0; k < n; ++k)
+		{
+			if (done[k])
+				continue;
+			// q and q' at r[k], Horner, with the bound of the rounding error on q
+			Complex v(c[n]);
+			Complex dv(0.);
+			const Real modulus = std::abs(r[k]);
+			Real bound = std::abs(c[n]);
+			for (std::size_t j = n; j-- > 0;)
+			{
+				dv = dv * r[k] + v;
+				v = v * r[k] + c[j];
+				bound = bound * modulus + std::abs(c[j]);
+			}
+			++this->stats.fEvals;
+			++this->stats.dfEvals;
+			// q(r[k]) is zero within the rounding: no correction is meaningful
+			if (std::abs(v) <= 4 * std::numeric_limits<Real>::epsilon() * bound)
+			{
+				done[k] = 1;
+				--left;
+				continue;
+			}
+			// The complex divisions are written out, std::complex checks for infinities
+			const Complex ratio = v * std::conj(dv) / std::norm(dv);
+			Complex sum(0.);
+			for (std::size_t j = 0; j < n; ++j)
+				if (j != k)
+				{
+					const Complex d = r[k] - r[j];
+					sum += std::conj(d) / std::norm(d);
+				}
+			const Complex den = Real(1) - ratio * sum;
+			const Complex w = ratio * std::conj(den) / std::norm(den);
+			r[k] -= w;
+			if (std::abs(w) <= tol * std::abs(r[k]))
+			{
+				done[k] = 1;
+				--left;
+			}
+		}
+	}
+	z.insert(z.end(), r.begin(), r.end());
+	return left == 0;
+}
+
+// Polynomial solver implementation
+/*!
+ * Computes all the roots and keeps as real the ones whose inclusion disk,
+ * of radius degree * |p / p'|, or whose imaginary part, below sqrt(tol)
+ * times the modulus, reaches the real axis. The real roots are polished
+ * with a few Newton steps on the real polynomial
+ *
+ * @return The smallest real root in [a, b] (NaN if there is none)
+ */
+template<class Traits>
+auto BasicPolynomialSolver<Traits>::solve() -> Real
+{
+	real.clear();
+	unsigned int iter{0u};
+	// A sweep that converges on iteration maxIt is a success, so the outcome is not read from iter
+	const bool converged = (p.degree() > 0) && aberth(iter);
+	if (!converged)
+	{
+		z.clear();
+		Logger::log(LogLevel::Error, "ERROR, could not find the roots of the polynomial");
+		this->setStats(p.degree() == 0 ? SolveStatus::InvalidInterval : SolveStatus::MaxIterations, iter, std::abs(p(a)));
+
+		return std::numeric_limits<Real>::quiet_NaN();
+	}
+
+	const Real imagTol = std::sqrt(tol);
+	const Real n = static_cast<Real>(p.degree());
+	for (const Complex& root : z)
+	{
+		Complex v(p.coefficients().back());
+		Complex dv(0.);
+		for (std::size_t j = p.degree(); j-- > 0;)
+		{
+			dv = dv * root + v;
+			v = v * root + p.coefficients()[j];
+		}
+		const Real radius = (v == Complex(0.)) ? Real(0) : n * std::abs(v / dv);
+		if (std::abs(root.imag()) > std::max(radius, imagTol * std::max(Real(1), std::abs(root))))
+			continue;
+
+		Real x = root.real();
+		for (int k = 0; k < 3; ++k)
+		{
+			const Dual<Real> y = p.valueAndDerivative(x);
+			++this->stats.fEvals;
+			++this->stats.dfEvals;
+			if (y.d == 0. || y.v == 0.)
+				break;
+			x -= y.v / y.d;
+		}
+		real.push_back(x);
+	}
+	std::sort(real.begin(), real.end());
+
+	const auto root = std::find_if(real.begin(), real.end(), [this](const Real& x) {return x >= a && x <= b;});
+	if (root == real.end())
+	{
+		Logger::log(LogLevel::Error, "ERROR, the polynomial has no real root in the interval");
+		this->setStats(SolveStatus::InvalidInterval, iter, std::abs(p(a)), b - a);
+
+		return std::numeric_limits<Real>::quiet_NaN();
+	}
+	this->setStats(SolveStatus::Converged, iter, std::abs(p(*root)));
+	return *root;
+}
+
+using Polynomial = BasicPolynomial<SolverTraits>;
+using PolynomialSolver = BasicPolynomialSolver<SolverTraits>;
+
+#endif
@@ -0,0 +1,100 @@
+#ifndef _ROOT_SCANNER_HPP_
+#define _ROOT_SCANNER_HPP_
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+#include "classZeroFun.hpp"
+#include "ThreadPool.hpp"
+
+// f with its values at the extremes of a subinterval, known from the
+// sampling: the Brent solve on it does not evaluate them again
+template<class F>
+struct SampledEnds
+{
+	using Real = SolverTraits::Real;
+
+	Real operator()(const Real& x) const {return (x == lo) ? ylo : (x == hi) ? yhi : f(x);}
+
+	const F& f;
+	Real lo;
+	Real ylo;
+	Real hi;
+	Real yhi;
+};
+
+// Find all the zeros of a function in an interval
+/*!
+ * The interval [lo, hi] is divided in n subintervals of the same length
+ * and f is sampled at their n + 1 extremes. Every subinterval where f
+ * changes sign is then refined with the Brent method, starting from the
+ * values of f at its extremes given by the sampling. Both the sampling
+ * and the refinement are done in parallel on the pool.
+ * Zeros closer than (hi - lo) / n may be missed, as well as zeros where f
+ * does not change sign (e.g. double roots), unless a sample hits them.
+ *
+ * @tparam F the type of the function. must be callable as Real(const Real&)
+ * @param f The function.
+ * @param lo lower extreme of the interval
+ * @param hi upper extreme of the interval
+ * @param n number of subintervals
+ * @param tol tolerance of the Brent method
+ * @param maxIt maximum number of iterations of the Brent method
+ * @param pool pool of threads used for sampling and refining
+ * @return the zeros found, in increasing order
+ */
+template<class F>
+std::vector<SolverTraits::Real> findAllRoots(const F& f, SolverTraits::Real lo, SolverTraits::Real hi, std::size_t n, SolverTraits::Real tol = 1e-10, unsigned int maxIt = 150, ThreadPool& pool = ThreadPool::shared())
+{
+	using Real = SolverTraits::Real;
+
+	std::vector<Real> zeros;
+	if (n == 0 || !(hi > lo))
+		return zeros;
+
+	// Sampling
+	const Real h = (hi - lo) / n;
+	std::vector<Real> x(n + 1);
+	std::vector<Real> y(n + 1);
+	pool.parallelFor(n + 1, [&](std::size_t i)
+	{
+		x[i] = (i == n) ? hi : lo + i * h;
+		y[i] = f(x[i]);
+	});
+
+	// Subintervals with a sign change; samples equal to zero are already roots
+	std::vector<std::size_t> brackets;
+	std::vector<char> exact(n + 1, 0);
+	for (std::size_t i = 0; i <= n; ++i)
+	{
+		exact[i] = (y[i] == 0.);
+		if (i < n && y[i] * y[i + 1] < 0)
+			brackets.push_back(i);
+	}
+
+	// Refinement, one Brent solve per task
+	std::vector<Real> refined(brackets.size());
+	pool.parallelFor(brackets.size(), [&](std::size_t k)
+	{
+		const std::size_t i = brackets[k];
+		const SampledEnds<F> g{f, x[i], y[i], x[i + 1], y[i + 1]};
+		refined[k] = BasicBrent<SolverTraits, SampledEnds<F>>(g, x[i], x[i + 1], tol, maxIt).solve();
+	}, 1);
+
+	// Merge in increasing order, dropping the solves that failed
+	std::size_t k = 0;
+	for (std::size_t i = 0; i <= n; ++i)
+	{
+		if (exact[i])
+			zeros.push_back(x[i]);
+		if (k < brackets.size() && brackets[k] == i)
+		{
+			if (!std::isnan(refined[k]))
+				zeros.push_back(refined[k]);
+			++k;
+		}
+	}
+	return zeros;
+}
+
+#endif
@@ -0,0 +1,73 @@
+#ifndef _SOLVE_STATS_HPP_
+#define _SOLVE_STATS_HPP_
+
+#include <cstddef>
+#include <limits>
+#include <vector>
+#include "SolverTraits.hpp"
+
+// Outcome of a solve
+enum class SolveStatus : char
+{
+	NotSolved,       // solve not called yet
+	Converged,       // the zero was found within the tolerance
+	InvalidInterval, // f does not change sign at the extremes and no valid interval was found
+	ChordFailed,     // the chord of the regula falsi left the interval
+	MaxIterations,   // maximum number of iterations reached
+	Diverged,        // the iterates are not finite
+	BudgetExhausted, // the evaluations allowed by the stopping policy are used up, the zero is the current estimate
+	DeadlineExceeded, // the time allowed by the stopping policy is over, the zero is the current estimate
+	EvaluationFailed, // an evaluation of f threw an exception (asynchronous solvers)
+	Stalled           // the iterates stagnate or oscillate (open methods in Auto)
+};
+
+// Name of a status
+inline const char* toString(const SolveStatus& status)
+{
+	static const char* names[] = {"NotSolved", "Converged", "InvalidInterval", "ChordFailed", "MaxIterations", "Diverged", "BudgetExhausted", "DeadlineExceeded", "EvaluationFailed", "Stalled"};
+	return names[static_cast<int>(status)];
+}
+
+// Kind of step taken by the Brent method at an iteration
+enum class BrentStep : char {Bisection, Interpolation};
+
+/* * * * * * * * * * * * * * * *
+ * Statistics of a solve       *
+ * * * * * * * * * * * * * * * */
+/*!
+ * Returned by solveWithStats. The counters of the first solve include the
+ * evaluations done by the constructor (extremes and bracketInterval).
+ * QuasiNewton evaluates only f, so all its evaluations, also those of the
+ * differences that approximate df, are counted in fEvals.
+ */
+template<class Traits>
+struct BasicSolveStats
+{
+	using Real = typename Traits::Real;
+
+	// Approximation of the zero (NaN if not found)
+	Real zero = std::numeric_limits<Real>::quiet_NaN();
+	// Outcome of the solve
+	SolveStatus status{SolveStatus::NotSolved};
+	// Number of evaluations of f
+	std::size_t fEvals{0u};
+	// Number of evaluations of the derivatives (f' and, for Halley, f'')
+	std::size_t dfEvals{0u};
+	// Number of iterations
+	unsigned int iterations{0u};
+	// Wall time of the solve, in seconds
+	double wallTime{0.};
+	// Absolute value of f at the last evaluated point
+	Real residual = std::numeric_limits<Real>::quiet_NaN();
+	// Width of the final bracket (NaN for methods without a bracket)
+	Real bracketWidth = std::numeric_limits<Real>::quiet_NaN();
+	// Step taken at every iteration (Brent only)
+	std::vector<BrentStep> brentSteps;
+
+	// True if the zero was found
+	bool ok() const {return status == SolveStatus::Converged;}
+};
+
+using SolveStats = BasicSolveStats<SolverTraits>;
+
+#endif
@@ -0,0 +1,299 @@
+#ifndef _SOLVER_BATCH_HPP_
+#define _SOLVER_BATCH_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+#include "SolveStats.hpp"
+#include "SolverParameters.hpp"
+
+/* * * * * * * * * * * * * * * * * * * * *
+ * Arena of aligned memory                *
+ * * * * * * * * * * * * * * * * * * * * */
+/*!
+ * Hands out arrays of trivial types from large blocks, aligned to a cache
+ * line (and to the widest SIMD register). Nothing is freed one by one:
+ * reset releases all the arrays at once and keeps the memory, merged in a
+ * single block, so that once a batch of the largest size has been laid out
+ * the following ones do not allocate.
+ */
+class Arena
+{
+public:
+	static constexpr std::size_t alignment = 64;
+
+	// Constructor, reserves capacity bytes
+	explicit Arena(std::size_t capacity = 0)
+	{
+		if (capacity > 0)
+			addBlock(capacity);
+	}
+
+	Arena(const Arena&) = delete;
+	Arena& operator=(const Arena&) = delete;
+
+	// Array of n values of X, value-initialized, valid until reset
+	template<class X>
+	X* allocate(std::size_t n)
+	{
+		static_assert(std::is_trivially_destructible<X>::value, "the arena does not call destructors");
+		const std::size_t bytes = roundUp(std::max<std::size_t>(1, n * sizeof(X)));
+		if (blocks.empty() || used + bytes > blocks.back().size)
+			addBlock(std::max(bytes, 2 * capacity()));
+		X* p = reinterpret_cast<X*>(blocks.back().data.get() + used);
+		used += bytes;
+		std::uninitialized_value_construct_n(p, n);
+		return p;
+	}
+
+	// Releases all the arrays, the memory is kept for the next ones
+	void reset()
+	{
+		if (blocks.size() > 1)
+		{
+			const std::size_t total = capacity();
+			blocks.clear();
+			addBlock(total);
+		}
+		used = 0;
+	}
+
+	// Bytes reserved
+	std::size_t capacity() const
+	{
+		std::size_t total{0};
+		for (const Block& block : blocks)
+			total += block.size;
+		return total;
+	}
+
+private:
+	struct Free
+	{
+		void operator()(unsigned char* p) const {std::free(p);}
+	};
+
+	struct Block
+	{
+		std::unique_ptr<unsigned char[], Free> data;
+		std::size_t size;
+	};
+
+	std::vector<Block> blocks;
+	// Bytes used in the last block
+	std::size_t used{0};
+
+	static std::size_t roundUp(std::size_t bytes) {return (bytes + alignment - 1) / alignment * alignment;}
+
+	void addBlock(std::size_t bytes)
+	{
+		bytes = roundUp(bytes);
+		unsigned char* p = static_cast<unsigned char*>(std::aligned_alloc(alignment, bytes));
+		if (!p)
+			throw std::bad_alloc();
+		blocks.push_back({std::unique_ptr<unsigned char[], Free>(p), bytes});
+		used = 0;
+	}
+};
+
+/* * * * * * * * * * * * * * * * * * * * *
+ * Problems as structure of arrays        *
+ * * * * * * * * * * * * * * * * * * * * */
+/*!
+ * The extremes a, b, the starting point x0 and the tolerance tol of n
+ * problems, each in a contiguous aligned column in the arena, so that a
+ * batched or parallel engine streams through them with no per-problem
+ * object. Growing beyond the capacity moves the columns to new arrays of
+ * the arena (the old ones are released by Arena::reset). A batch can also
+ * be a view of columns owned elsewhere, e.g. a mapped file, which cannot
+ * grow.
+ */
+template<class Traits>
+class BasicProblemBatch
+{
+public:
+	using Real = typename Traits::Real;
+	using Problem = BasicSolverProblem<Traits>;
+
+	explicit BasicProblemBatch(Arena& arena_, std::size_t n_ = 0) : arena(&arena_) {resize(n_);}
+
+	// View of n_ problems in the given columns
+	BasicProblemBatch(Real* a_, Real* b_, Real* x0_, Real* tol_, std::size_t n_) :
+		n(n_), capacity(n_), as(a_), bs(b_), x0s(x0_), tols(tol_) {}
+
+	// Changes the number of problems, keeping the first ones
+	void resize(std::size_t n_)
+	{
+		if (n_ > capacity)
+		{
+			const std::size_t c = std::max(n_, 2 * capacity);
+			move(as, c);
+			move(bs, c);
+			move(x0s, c);
+			move(tols, c);
+			capacity = c;
+		}
+		n = n_;
+	}
+
+	// Number of problems
+	std::size_t size() const {return n;}
+
+	// Columns
+	Real* a() {return as;}
+	Real* b() {return bs;}
+	Real* x0() {return x0s;}
+	Real* tol() {return tols;}
+	const Real* a() const {return as;}
+	const Real* b() const {return bs;}
+	const Real* x0() const {return x0s;}
+	const Real* tol() const {return tols;}
+
+	// Sets problem i
+	void set(std::size_t i, const Problem& p, const Real& tol_)
+	{
+		as[i] = p.a;
+		bs[i] = p.b;
+		x0s[i] = p.x0;
+		tols[i] = tol_;
+	}
+
+	// Adds a problem
+	void push_back(const Problem& p, const Real& tol_)
+	{
+		resize(n + 1);
+		set(n - 1, p, tol_);
+	}
+
+	// Problem i
+	Problem problem(std::size_t i) const {return {as[i], bs[i], x0s[i]};}
+
+private:
+	// Null for a view
+	Arena* arena{nullptr};
+	std::size_t n{0};
+	std::size_t capacity{0};
+	Real* as{nullptr};
+	Real* bs{nullptr};
+	Real* x0s{nullptr};
+	Real* tols{nullptr};
+
+	// Moves a column to an array of c values
+	void move(Real*& column, std::size_t c)
+	{
+		if (!arena)
+			throw std::length_error("a view of a batch cannot grow");
+		Real* p = arena->allocate<Real>(c);
+		if (column)
+			std::copy(column, column + n, p);
+		column = p;
+	}
+};
+
+/* * * * * * * * * * * * * * * * * * * * *
+ * Results as structure of arrays         *
+ * * * * * * * * * * * * * * * * * * * * */
+/*!
+ * The zero, the status, the iterations and the evaluations of f and df of
+ * n solves, in columns of the arena or a view, as for BasicProblemBatch
+ */
+template<class Traits>
+class BasicResultBatch
+{
+public:
+	using Real = typename Traits::Real;
+
+	explicit BasicResultBatch(Arena& arena_, std::size_t n_ = 0) : arena(&arena_) {resize(n_);}
+
+	// View of n_ results in the given columns
+	BasicResultBatch(Real* zero_, SolveStatus* status_, unsigned int* iterations_, std::size_t* fEvals_, std::size_t* dfEvals_, std::size_t n_) :
+		n(n_), capacity(n_), zeros(zero_), statuses(status_), iters(iterations_), fEvalCounts(fEvals_), dfEvalCounts(dfEvals_) {}
+
+	// Changes the number of results, keeping the first ones
+	void resize(std::size_t n_)
+	{
+		if (n_ > capacity)
+		{
+			const std::size_t c = std::max(n_, 2 * capacity);
+			move(zeros, c);
+			move(statuses, c);
+			move(iters, c);
+			move(fEvalCounts, c);
+			move(dfEvalCounts, c);
+			capacity = c;
+		}
+		n = n_;
+	}
+
+	// Number of results
+	std::size_t size() const {return n;}
+
+	// Columns
+	Real* zero() {return zeros;}
+	SolveStatus* status() {return statuses;}
+	unsigned int* iterations() {return iters;}
+	std::size_t* fEvals() {return fEvalCounts;}
+	std::size_t* dfEvals() {return dfEvalCounts;}
+	const Real* zero() const {return zeros;}
+	const SolveStatus* status() const {return statuses;}
+	const unsigned int* iterations() const {return iters;}
+	const std::size_t* fEvals() const {return fEvalCounts;}
+	const std::size_t* dfEvals() const {return dfEvalCounts;}
+
+	// Stores the statistics of solve i
+	void store(std::size_t i, const BasicSolveStats<Traits>& s)
+	{
+		zeros[i] = s.zero;
+		statuses[i] = s.status;
+		iters[i] = s.iterations;
+		fEvalCounts[i] = s.fEvals;
+		dfEvalCounts[i] = s.dfEvals;
+	}
+
+	// Statistics of solve i (without times and residuals)
+	BasicSolveStats<Traits> stats(std::size_t i) const
+	{
+		BasicSolveStats<Traits> s;
+		s.zero = zeros[i];
+		s.status = statuses[i];
+		s.iterations = iters[i];
+		s.fEvals = fEvalCounts[i];
+		s.dfEvals = dfEvalCounts[i];
+		return s;
+	}
+
+	// Number of solves that converged
+	std::size_t converged() const {return std::count(statuses, statuses + n, SolveStatus::Converged);}
+
+private:
+	// Null for a view
+	Arena* arena{nullptr};
+	std::size_t n{0};
+	std::size_t capacity{0};
+	Real* zeros{nullptr};
+	SolveStatus* statuses{nullptr};
+	unsigned int* iters{nullptr};
+	std::size_t* fEvalCounts{nullptr};
+	std::size_t* dfEvalCounts{nullptr};
+
+	template<class X>
+	void move(X*& column, std::size_t c)
+	{
+		if (!arena)
+			throw std::length_error("a view of a batch cannot grow");
+		X* p = arena->allocate<X>(c);
+		if (column)
+			std::copy(column, column + n, p);
+		column = p;
+	}
+};
+
+using ProblemBatch = BasicProblemBatch<SolverTraits>;
+using ResultBatch = BasicResultBatch<SolverTraits>;
+
+#endif
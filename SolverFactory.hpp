@@ -1,20 +1,179 @@
 #ifndef _SOLVER_FACTORY_HPP_
 #define _SOLVER_FACTORY_HPP_
 
+#include <algorithm>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <shared_mutex>
 #include <string>
 #include <type_traits>
+#include <unordered_map>
+#include <vector>
+#include <dlfcn.h>
 #include "classZeroFun.hpp"
+#include "SolverParameters.hpp"
+#include "PolynomialSolver.hpp"
+#include "IntervalNewton.hpp"
 
-// Simple factory for solver initialization
-class SolverFactory 
+// Automatic choice of the method, in AutoSolver.hpp
+template<class Traits>
+class BasicAutoSolver;
+
+/*!
+ * Factory for solver initialization, for the precision of the traits.
+ * The methods chosen by name at runtime are kept in a registry shared by
+ * all the factories of the same traits: the built-in ones (and Auto, the
+ * automatic choice among them) are registered on first use, others can be
+ * added with registerSolver or loaded from a shared library with
+ * loadPlugin.
+ */
+template<class Traits>
+class BasicSolverFactory
 {
 public:
+	using T = Traits;
+	using Solver = std::unique_ptr<BasicSolverBase<T>>;
+	// Builds a solver from the functions and the parameters, nullptr if a function it needs is not given
+	using Creator = std::function<Solver(const BasicSolverFunctions<T>&, const BasicSolverParameters<T>&)>;
+	// Function that registers a method, passed to the plugins
+	using Registrar = void (*)(const std::string&, Creator);
+	// Entry point of a plugin, extern "C" void registerSolvers(Registrar)
+	using PluginEntry = void (*)(Registrar);
+
 	template<class SolverType, class ... Args>
-	std::unique_ptr<SolverBase> make_solver(const Args&... args) const
+	Solver make_solver(const Args&... args) const
+	{
+		return std::make_unique<SolverType>(args...);
+	}
+
+	// Solver chosen by name at runtime, nullptr if the method does not exist
+	// or needs a function that is not given
+	Solver make_solver(const std::string& method, const BasicSolverFunctions<T>& fs, const BasicSolverParameters<T>& p) const
+	{
+		const Registry& r = registry();
+		std::shared_lock<std::shared_mutex> lock(r.mutex);
+		const auto it = r.creators.find(method);
+		return (it == r.creators.end()) ? nullptr : it->second(fs, p);
+	}
+
+	// Adds a method, or replaces the one with the same name
+	static void registerSolver(const std::string& method, Creator creator)
+	{
+		Registry& r = registry();
+		std::unique_lock<std::shared_mutex> lock(r.mutex);
+		r.creators[method] = std::move(creator);
+	}
+
+	// True if the method is registered
+	static bool hasMethod(const std::string& method)
+	{
+		const Registry& r = registry();
+		std::shared_lock<std::shared_mutex> lock(r.mutex);
+		return r.creators.count(method) > 0;
+	}
+
+	// Names of the registered methods, sorted
+	static std::vector<std::string> methods()
 	{
-		return std::make_unique<SolverType>(args...);	
+		const Registry& r = registry();
+		std::shared_lock<std::shared_mutex> lock(r.mutex);
+		std::vector<std::string> names;
+		for (const auto& c : r.creators)
+			names.push_back(c.first);
+		std::sort(names.begin(), names.end());
+		return names;
+	}
+
+	// Loads a shared library and calls its entry point to register its methods
+	/*!
+	 * The library stays loaded, the creators it registered refer to its code
+	 *
+	 * @return false if the library or its entry point cannot be found
+	 */
+	static bool loadPlugin(const std::string& path, const std::string& entry = "registerSolvers")
+	{
+		void* handle = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+		if (!handle)
+		{
+			Logger::log(LogLevel::Error, "ERROR, cannot load the plugin: ", dlerror());
+			return false;
+		}
+		const PluginEntry registerSolvers = reinterpret_cast<PluginEntry>(dlsym(handle, entry.c_str()));
+		if (!registerSolvers)
+		{
+			Logger::log(LogLevel::Error, "ERROR, the plugin ", path, " has no ", entry);
+			dlclose(handle);
+			return false;
+		}
+		registerSolvers(&BasicSolverFactory::registerSolver);
+		Logger::log(LogLevel::Info, "Plugin loaded: ", path);
+		return true;
+	}
+
+private:
+	struct Registry
+	{
+		std::unordered_map<std::string, Creator> creators;
+		mutable std::shared_mutex mutex;
+	};
+
+	static Registry& registry()
+	{
+		static Registry r{builtins(), {}};
+		return r;
+	}
+
+	// The methods of this library
+	static std::unordered_map<std::string, Creator> builtins()
+	{
+		using Functions = BasicSolverFunctions<T>;
+		using Parameters = BasicSolverParameters<T>;
+		const BasicSolverFactory factory;
+		std::unordered_map<std::string, Creator> c;
+		c["RegulaFalsi"] = [factory](const Functions& fs, const Parameters& p)
+			{return factory.make_solver<BasicRegulaFalsi<T>>(fs.f, p.a, p.b, p.tol, p.tola, p.h_interval, p.maxIter, p.strategy);};
+		c["Illinois"] = [factory](const Functions& fs, const Parameters& p)
+			{return factory.make_solver<BasicModifiedRegulaFalsi<T>>(fs.f, p.a, p.b, p.tol, p.tola, p.maxIt, SideScaling::Illinois, p.h_interval, p.maxIter, p.strategy);};
+		c["AndersonBjorck"] = [factory](const Functions& fs, const Parameters& p)
+			{return factory.make_solver<BasicModifiedRegulaFalsi<T>>(fs.f, p.a, p.b, p.tol, p.tola, p.maxIt, SideScaling::AndersonBjorck, p.h_interval, p.maxIter, p.strategy);};
+		c["Bisection"] = [factory](const Functions& fs, const Parameters& p)
+			{return factory.make_solver<BasicBisection<T>>(fs.f, p.a, p.b, p.tol, p.h_interval, p.maxIter, p.strategy);};
+		c["Multisection"] = [factory](const Functions& fs, const Parameters& p)
+			{return factory.make_solver<BasicMultisection<T>>(fs.f, p.a, p.b, p.tol, p.sections, &ThreadPool::shared(), p.h_interval, p.maxIter, p.strategy);};
+		c["Secant"] = [factory](const Functions& fs, const Parameters& p)
+			{return factory.make_solver<BasicSecant<T>>(fs.f, p.a, p.b, p.tol, p.tola, p.maxIt, p.h_interval, p.maxIter, p.strategy);};
+		c["Brent"] = [factory](const Functions& fs, const Parameters& p)
+			{return factory.make_solver<BasicBrent<T>>(fs.f, p.a, p.b, p.tol, p.maxIt, p.h_interval, p.maxIter, p.strategy);};
+		c["Newton"] = [factory](const Functions& fs, const Parameters& p)
+			{return fs.df ? factory.make_solver<BasicNewton<T>>(fs.f, fs.df, p.x0, p.tol, p.tola, p.maxIt) : nullptr;};
+		c["SafeNewton"] = [factory](const Functions& fs, const Parameters& p) -> Solver
+		{
+			if (!fs.df && !fs.fd)
+				return nullptr;
+			const typename T::FunType df = fs.df ? fs.df : typename T::FunType(DualDerivative<T, typename T::DualFunType>{fs.fd});
+			return factory.make_solver<BasicSafeNewton<T>>(fs.f, df, p.a, p.b, p.tol, p.tola, p.maxIt, p.h_interval, p.maxIter, p.strategy);
+		};
+		c["Halley"] = [factory](const Functions& fs, const Parameters& p)
+			{return (fs.df && fs.d2f) ? factory.make_solver<BasicHalley<T>>(fs.f, fs.df, fs.d2f, p.x0, p.tol, p.tola, p.maxIt) : nullptr;};
+		c["Steffensen"] = [factory](const Functions& fs, const Parameters& p)
+			{return factory.make_solver<BasicSteffensen<T>>(fs.f, p.x0, p.tol, p.tola, p.maxIt);};
+		c["QuasiNewton"] = [factory](const Functions& fs, const Parameters& p)
+			{return factory.make_solver<BasicQuasiNewton<T>>(fs.f, p.x0, p.h, p.tol, p.tola, p.maxIt, p.slope, p.refresh);};
+		c["AutoDiffNewton"] = [factory](const Functions& fs, const Parameters& p)
+			{return fs.fd ? factory.make_solver<BasicAutoDiffNewton<T>>(fs.fd, p.x0, p.tol, p.tola, p.maxIt) : nullptr;};
+		c["Polynomial"] = [factory](const Functions& fs, const Parameters& p)
+			{return !fs.coefficients.empty() ? factory.make_solver<BasicPolynomialSolver<T>>(BasicPolynomial<T>(fs.coefficients), p.a, p.b, p.tol, p.maxIt) : nullptr;};
+		c["IntervalNewton"] = [factory](const Functions& fs, const Parameters& p)
+			{return (fs.fi && fs.dfi) ? factory.make_solver<BasicIntervalNewton<T>>(fs.fi, fs.dfi, p.a, p.b, p.tol, p.maxIt) : nullptr;};
+		c["Auto"] = [factory](const Functions& fs, const Parameters& p)
+			{return factory.make_solver<BasicAutoSolver<T>>(fs, p);};
+		return c;
 	}
 };
 
+using SolverFactory = BasicSolverFactory<SolverTraits>;
+
+#include "AutoSolver.hpp"
+
 #endif
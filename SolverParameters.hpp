@@ -0,0 +1,117 @@
+#ifndef _SOLVER_PARAMETERS_HPP_
+#define _SOLVER_PARAMETERS_HPP_
+
+#include <vector>
+#include "SolverTraits.hpp"
+
+// Strategy used to search an interval containing the zero
+enum class BracketStrategy
+{
+	Linear,       // walk with a step growing by 1.5 at every iteration
+	Golden,       // expand both extremes by the golden ratio
+	Extrapolation // walk with steps predicted by quadratic/secant extrapolation
+};
+
+// Approximation of the derivative in the QuasiNewton method
+enum class SlopeUpdate
+{
+	Central, // central difference at every iteration, two more evaluations of f
+	Forward, // one-sided difference reusing f(x), one more evaluation
+	Secant,  // slope through the last two iterates, no more evaluations after the first
+	Chord    // one-sided difference every refresh iterations, kept in between (Shamanskii)
+};
+
+// Parameters of all the solvers, each method uses only some of them (see data.dat)
+template<class Traits>
+struct BasicSolverParameters
+{
+	using Real = typename Traits::Real;
+
+	// Interval lower extreme
+	Real a{-1.};
+	// Interval upper extreme
+	Real b{1.};
+	// Tolerance
+	Real tol{1e-4};
+	// Absolute tolerance
+	Real tola{1e-10};
+	// Max number of iterations for the methods
+	unsigned int maxIt{150};
+	// Step for the bracket interval function
+	Real h_interval{0.01};
+	// Max number of iterations for the bracket interval function
+	unsigned int maxIter{200};
+	// Starting point for Newton-like methods
+	Real x0{0.};
+	// Step for the derivative approximation in the QuasiNewton method
+	Real h{1e-3};
+	// Strategy for the bracket interval function
+	BracketStrategy strategy{BracketStrategy::Linear};
+	// Number of parts of the interval at every iteration of the Multisection method
+	unsigned int sections{4};
+	// Approximation of the derivative in the QuasiNewton method
+	SlopeUpdate slope{SlopeUpdate::Central};
+	// Iterations between two differences of the Chord slope of the QuasiNewton method
+	unsigned int refresh{5};
+};
+
+// Data of a single problem, the other parameters are those of the solver
+template<class Traits>
+struct BasicSolverProblem
+{
+	using Real = typename Traits::Real;
+
+	// Interval lower extreme
+	Real a{-1.};
+	// Interval upper extreme
+	Real b{1.};
+	// Starting point for Newton-like methods
+	Real x0{0.};
+};
+
+// Functions of a problem, each method uses only some of them
+template<class Traits>
+struct BasicSolverFunctions
+{
+	// Function
+	typename Traits::FunType f;
+	// Derivative (Newton, Halley)
+	typename Traits::FunType df;
+	// Second derivative (Halley)
+	typename Traits::FunType d2f;
+	// Function on dual numbers (AutoDiffNewton)
+	typename Traits::DualFunType fd;
+	// Coefficients when f is a polynomial, from the lowest degree (PolynomialSolver)
+	std::vector<typename Traits::Real> coefficients;
+	// Interval extensions of f and of its derivative (IntervalNewton)
+	typename Traits::IntervalFunType fi;
+	typename Traits::IntervalFunType dfi;
+};
+
+// Parameters in the precision of the traits To, e.g. for a coarse solve in float
+template<class To, class From>
+BasicSolverParameters<To> convertParameters(const BasicSolverParameters<From>& p)
+{
+	using Real = typename To::Real;
+	BasicSolverParameters<To> q;
+	q.a = static_cast<Real>(p.a);
+	q.b = static_cast<Real>(p.b);
+	q.tol = static_cast<Real>(p.tol);
+	q.tola = static_cast<Real>(p.tola);
+	q.maxIt = p.maxIt;
+	q.h_interval = static_cast<Real>(p.h_interval);
+	q.maxIter = p.maxIter;
+	q.x0 = static_cast<Real>(p.x0);
+	q.h = static_cast<Real>(p.h);
+	q.strategy = p.strategy;
+	q.sections = p.sections;
+	q.slope = p.slope;
+	q.refresh = p.refresh;
+	return q;
+}
+
+using SolverParameters = BasicSolverParameters<SolverTraits>;
+using SolverProblem = BasicSolverProblem<SolverTraits>;
+using SolverFunctions = BasicSolverFunctions<SolverTraits>;
+
+#endif
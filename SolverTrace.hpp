@@ -0,0 +1,152 @@
+#ifndef _SOLVER_TRACE_HPP_
+#define _SOLVER_TRACE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <ostream>
+#include <vector>
+#include "SolverTraits.hpp"
+
+// The trace is compiled in only with -DZEROFUN_TRACE (for all the objects, the library included)
+#ifdef ZEROFUN_TRACE
+constexpr bool traceEnabled = true;
+#else
+constexpr bool traceEnabled = false;
+#endif
+
+// Kind of step that gave the point of an iteration
+enum class TraceStep : char {Bisection, Multisection, Chord, Secant, Interpolation, Newton, Halley, Steffensen};
+
+// Name of a step
+inline const char* toString(const TraceStep& step)
+{
+	static const char* names[] = {"Bisection", "Multisection", "Chord", "Secant", "Interpolation", "Newton", "Halley", "Steffensen"};
+	return names[static_cast<int>(step)];
+}
+
+// One iteration of a solve
+template<class Real>
+struct TraceRecord
+{
+	// Number of the solve in the thread and method (a string literal)
+	std::uint64_t solve;
+	const char* method;
+	unsigned int iteration;
+	TraceStep step;
+	// Point of the iteration and value of f at it
+	Real x;
+	Real fx;
+	// Bracket after the iteration (NaN for the methods without one)
+	Real a;
+	Real b;
+};
+
+/* * * * * * * * * * * * * * * * * * * * *
+ * Per-thread trace of the iterations     *
+ * * * * * * * * * * * * * * * * * * * * */
+/*!
+ * A ring buffer allocated once, in which the solvers compiled with
+ * ZEROFUN_TRACE write a record per iteration: when it is full the oldest
+ * records are overwritten, so a record costs a few stores and no
+ * allocation nor lock. Every thread has its own trace, local(), which it
+ * only reads and writes; the records of a thread can be exported, as CSV
+ * or JSON, from that thread or after it stopped solving. Without
+ * ZEROFUN_TRACE the solvers write nothing and the calls are compiled away.
+ */
+template<class Real>
+class BasicSolverTrace
+{
+public:
+	using Record = TraceRecord<Real>;
+
+	static constexpr std::size_t defaultCapacity = 4096;
+
+	explicit BasicSolverTrace(std::size_t capacity = defaultCapacity) : ring(capacity > 0 ? capacity : 1) {}
+
+	// Trace of the calling thread
+	static BasicSolverTrace& local()
+	{
+		thread_local BasicSolverTrace trace;
+		return trace;
+	}
+
+	// Changes the number of records kept, clearing the trace
+	void setCapacity(std::size_t capacity)
+	{
+		ring.assign(capacity > 0 ? capacity : 1, Record{});
+		clear();
+	}
+
+	std::size_t capacity() const {return ring.size();}
+
+	// Starts a new solve, returns its number
+	std::uint64_t begin() {return ++solves;}
+
+	// Writes a record, overwriting the oldest if the trace is full
+	void record(std::uint64_t solve, const char* method, unsigned int iteration, TraceStep step, const Real& x, const Real& fx, const Real& a, const Real& b)
+	{
+		ring[next % ring.size()] = {solve, method, iteration, step, x, fx, a, b};
+		++next;
+	}
+
+	// Number of records kept
+	std::size_t size() const {return next < ring.size() ? next : ring.size();}
+
+	// Number of records overwritten
+	std::size_t dropped() const {return next - size();}
+
+	// Records kept, from the oldest
+	std::vector<Record> records() const
+	{
+		std::vector<Record> out;
+		out.reserve(size());
+		for (std::size_t k = next - size(); k < next; ++k)
+			out.push_back(ring[k % ring.size()]);
+		return out;
+	}
+
+	// Removes all the records
+	void clear() {next = 0;}
+
+	// One line per record, with a header
+	void writeCsv(std::ostream& out) const
+	{
+		const auto precision = out.precision(std::numeric_limits<Real>::max_digits10);
+		out << "solve,method,iteration,step,x,fx,a,b\n";
+		for (const Record& r : records())
+			out << r.solve << ',' << r.method << ',' << r.iteration << ',' << toString(r.step) << ',' << r.x << ',' << r.fx << ',' << r.a << ',' << r.b << '\n';
+		out.precision(precision);
+	}
+
+	// Array of objects, NaN and infinite values as null
+	void writeJson(std::ostream& out) const
+	{
+		const auto precision = out.precision(std::numeric_limits<Real>::max_digits10);
+		auto number = [&out](const Real& v) -> std::ostream& {return (v - v == 0) ? out << v : out << "null";};
+		out << "[";
+		bool first{true};
+		for (const Record& r : records())
+		{
+			out << (first ? "\n" : ",\n") << "  {\"solve\": " << r.solve << ", \"method\": \"" << r.method << "\", \"iteration\": " << r.iteration << ", \"step\": \"" << toString(r.step) << "\", \"x\": ";
+			number(r.x) << ", \"fx\": ";
+			number(r.fx) << ", \"a\": ";
+			number(r.a) << ", \"b\": ";
+			number(r.b) << "}";
+			first = false;
+		}
+		out << "\n]\n";
+		out.precision(precision);
+	}
+
+private:
+	std::vector<Record> ring;
+	// Records written since the last clear
+	std::size_t next{0};
+	// Solves started in the thread
+	std::uint64_t solves{0};
+};
+
+using SolverTrace = BasicSolverTrace<SolverTraits::Real>;
+
+#endif
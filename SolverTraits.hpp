@@ -3,17 +3,43 @@
 
 #include <iostream>
 #include <functional>
+#include <future>
 #include <limits>
 #include <cmath>
+#include "Float128.hpp"
+#include "Dual.hpp"
+#include "Interval.hpp"
 
-class SolverTraits
+/*!
+ * Types used by the solvers, for the floating point type R. The whole
+ * hierarchy is templated on the traits: float for fast coarse solves,
+ * double by default, long double for the final polishing, __float128
+ * (where GCC has it, Float128.hpp) for quadruple precision.
+ */
+template<class R>
+class BasicSolverTraits
 {
 public:
 	// Result type
-	using Real = double;
+	using Real = R;
 	// Function type
 	using FunType =	std::function<Real(const Real&)>;
+	// Function type with a parameter, f(x; p)
+	using ParamFunType = std::function<Real(const Real&, const Real&)>;
+	// Function type evaluated on dual numbers, gives f and f'
+	using DualFunType = std::function<Dual<Real>(const Dual<Real>&)>;
+	// Function type evaluated on intervals, encloses the range of f
+	using IntervalFunType = std::function<Interval<Real>(const Interval<Real>&)>;
+	// Function type returning a future of the value, e.g. a remote evaluation
+	using AsyncFunType = std::function<std::future<Real>(const Real&)>;
 
 };
 
+using SolverTraits = BasicSolverTraits<double>;
+using FloatSolverTraits = BasicSolverTraits<float>;
+using LongDoubleSolverTraits = BasicSolverTraits<long double>;
+#ifdef ZEROFUN_FLOAT128
+using Float128SolverTraits = BasicSolverTraits<__float128>;
+#endif
+
 #endif
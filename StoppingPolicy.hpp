@@ -0,0 +1,84 @@
+#ifndef _STOPPING_POLICY_HPP_
+#define _STOPPING_POLICY_HPP_
+
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include "SolverTraits.hpp"
+
+/* * * * * * * * * * * * * * * * * * * * * *
+ * Stopping policy added to a solver       *
+ * * * * * * * * * * * * * * * * * * * * * */
+/*!
+ * Criteria checked at the end of every iteration, together with the
+ * built-in one of the method, which still applies: the solve stops at the
+ * first that holds. The tests are on the iterate x, on the last step dx
+ * (the width of the bracket for Bisection, Brent and the modified regula
+ * falsi) and on the residual |f(x)|:
+ *  - step: converged when |dx| <= step;
+ *  - residual: converged when |f(x)| <= residual;
+ *  - with both step and residual set, both must hold (combined test), or
+ *    one of them if either is true;
+ *  - ulps: converged when |dx| is at most ulps units in the last place of x;
+ *  - custom: converged when custom(x, dx, fx) is true.
+ * The limits stop the solve with the current estimate of the zero, with
+ * status BudgetExhausted or DeadlineExceeded instead of a NaN:
+ *  - maxEvals: evaluations of f and its derivatives in the solve;
+ *  - deadline: microseconds from the start of the solve.
+ * A null field disables its test, e.g.
+ *
+ *   solver.setStoppingPolicy(StoppingPolicy::budget(20));
+ */
+template<class Traits>
+struct BasicStoppingPolicy
+{
+	using Real = typename Traits::Real;
+
+	// Maximum step (0 disables)
+	Real step{0.};
+	// Maximum residual (0 disables)
+	Real residual{0.};
+	// With step and residual, converged when either holds instead of both
+	bool either{false};
+	// Maximum step in units in the last place of the iterate (0 disables)
+	unsigned int ulps{0u};
+	// Maximum number of evaluations (0 disables)
+	std::size_t maxEvals{0u};
+	// Maximum time of the solve, in microseconds (0 disables)
+	double deadline{0.};
+	// Test of the user on x, dx and f(x) (empty disables)
+	std::function<bool(const Real&, const Real&, const Real&)> custom;
+
+	// Some criterion is set
+	bool active() const {return step > 0 || residual > 0 || ulps > 0 || maxEvals > 0 || deadline > 0 || custom;}
+
+	// True if the convergence tests hold at x
+	bool converged(const Real& x, const Real& dx, const Real& fx) const
+	{
+		const bool stepOk = step > 0 && std::abs(dx) <= step;
+		const bool residOk = residual > 0 && std::abs(fx) <= residual;
+		if (step > 0 && residual > 0 ? (either ? stepOk || residOk : stepOk && residOk) : stepOk || residOk)
+			return true;
+		if (ulps > 0)
+		{
+			const Real ax = std::abs(x);
+			const Real ulp = std::nextafter(ax, std::numeric_limits<Real>::infinity()) - ax;
+			if (std::abs(dx) <= ulps * ulp)
+				return true;
+		}
+		return custom && custom(x, dx, fx);
+	}
+
+	// Policies of a single criterion
+	static BasicStoppingPolicy stepSize(const Real& step_) {BasicStoppingPolicy p; p.step = step_; return p;}
+	static BasicStoppingPolicy residualSize(const Real& residual_) {BasicStoppingPolicy p; p.residual = residual_; return p;}
+	static BasicStoppingPolicy combined(const Real& step_, const Real& residual_) {BasicStoppingPolicy p; p.step = step_; p.residual = residual_; return p;}
+	static BasicStoppingPolicy ulp(const unsigned int& ulps_) {BasicStoppingPolicy p; p.ulps = ulps_; return p;}
+	static BasicStoppingPolicy budget(const std::size_t& maxEvals_) {BasicStoppingPolicy p; p.maxEvals = maxEvals_; return p;}
+	static BasicStoppingPolicy deadlineIn(const double& microseconds) {BasicStoppingPolicy p; p.deadline = microseconds; return p;}
+};
+
+using StoppingPolicy = BasicStoppingPolicy<SolverTraits>;
+
+#endif
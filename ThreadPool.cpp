@@ -0,0 +1,95 @@
+#include "ThreadPool.hpp"
+#include <algorithm>
+
+ThreadPool::ThreadPool(unsigned int nThreads)
+{
+	nThreads = std::max(1u, nThreads);
+	for (unsigned int i = 0; i < nThreads; ++i)
+		queues.push_back(std::make_unique<Queue>());
+	for (unsigned int i = 0; i < nThreads; ++i)
+		workers.emplace_back(&ThreadPool::work, this, i);
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(m);
+		stop = true;
+	}
+	cv.notify_all();
+	for (auto& worker : workers)
+		worker.join();
+}
+
+ThreadPool& ThreadPool::shared()
+{
+	static ThreadPool pool;
+	return pool;
+}
+
+void ThreadPool::submit(Task task)
+{
+	Queue& queue = *queues[next++ % queues.size()];
+	{
+		std::lock_guard<std::mutex> lock(queue.m);
+		queue.tasks.push_back(std::move(task));
+	}
+	++queued;
+	// Taking the lock guarantees that a worker is either waiting or will see the new task
+	{
+		std::lock_guard<std::mutex> lock(m);
+	}
+	cv.notify_one();
+}
+
+bool ThreadPool::pop(std::size_t id, Task& task)
+{
+	if (queued == 0)
+		return false;
+
+	const std::size_t n = queues.size();
+	// Own queue first, from the back
+	if (id < n)
+	{
+		Queue& queue = *queues[id];
+		std::lock_guard<std::mutex> lock(queue.m);
+		if (!queue.tasks.empty())
+		{
+			task = std::move(queue.tasks.back());
+			queue.tasks.pop_back();
+			--queued;
+			return true;
+		}
+	}
+	// Steal from the front of the other queues
+	for (std::size_t k = 1; k <= n; ++k)
+	{
+		Queue& queue = *queues[(id + k) % n];
+		std::lock_guard<std::mutex> lock(queue.m);
+		if (!queue.tasks.empty())
+		{
+			task = std::move(queue.tasks.front());
+			queue.tasks.pop_front();
+			--queued;
+			return true;
+		}
+	}
+	return false;
+}
+
+void ThreadPool::work(std::size_t id)
+{
+	Task task;
+	while (true)
+	{
+		if (pop(id, task))
+		{
+			task();
+			continue;
+		}
+		std::unique_lock<std::mutex> lock(m);
+		cv.wait(lock, [this]() {return stop || queued > 0;});
+		if (stop && queued == 0)
+			return;
+	}
+}
@@ -0,0 +1,128 @@
+#ifndef _THREAD_POOL_HPP_
+#define _THREAD_POOL_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/* * * * * * * * * * * * * * * * *
+ * Work-stealing pool of threads *
+ * * * * * * * * * * * * * * * * */
+/*!
+ * Every worker owns a queue of tasks: it takes the tasks from the back of
+ * its own queue and, when the queue is empty, steals them from the front of
+ * the queues of the other workers. Tasks are distributed round-robin.
+ * The thread calling parallelFor runs tasks too while it waits, so that
+ * parallelFor can also be called from inside a task.
+ */
+class ThreadPool
+{
+public:
+	using Task = std::function<void()>;
+
+	// Constructor, starts nThreads workers (at least one)
+	explicit ThreadPool(unsigned int nThreads = std::thread::hardware_concurrency());
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	// Waits for the queued tasks and joins the workers
+	~ThreadPool();
+
+	// Pool with one worker per core, shared by the whole program
+	static ThreadPool& shared();
+
+	// Number of workers
+	unsigned int size() const {return workers.size();}
+
+	// Queues a task
+	void submit(Task task);
+
+	// Runs body(i) for every i in [0, n) in chunks of grain indices (0 = automatic) and waits for them
+	template<class Body>
+	void parallelFor(std::size_t n, const Body& body, std::size_t grain = 0);
+
+private:
+	// Queue of a worker
+	struct Queue
+	{
+		std::mutex m;
+		std::deque<Task> tasks;
+	};
+
+	std::vector<std::unique_ptr<Queue>> queues;
+	std::vector<std::thread> workers;
+	// Number of tasks in the queues
+	std::atomic<std::size_t> queued{0};
+	// Queue that receives the next submitted task
+	std::atomic<std::size_t> next{0};
+	// Used by the workers to sleep while there are no tasks
+	std::mutex m;
+	std::condition_variable cv;
+	bool stop{false};
+
+	// Takes a task from queue id, or steals one from the others (id == size() only steals)
+	bool pop(std::size_t id, Task& task);
+
+	// Loop executed by worker id
+	void work(std::size_t id);
+};
+
+template<class Body>
+void ThreadPool::parallelFor(std::size_t n, const Body& body, std::size_t grain)
+{
+	if (n == 0)
+		return;
+	if (grain == 0)
+		grain = std::max<std::size_t>(1, n / (8 * size()));
+
+	const std::size_t nChunks = (n + grain - 1) / grain;
+	std::atomic<std::size_t> remaining{nChunks};
+	std::mutex doneM;
+	std::condition_variable doneCv;
+	std::exception_ptr error;
+
+	for (std::size_t begin = 0; begin < n; begin += grain)
+	{
+		const std::size_t end = std::min(n, begin + grain);
+		submit([&, begin, end]()
+		{
+			try
+			{
+				for (std::size_t i = begin; i < end; ++i)
+					body(i);
+			}
+			catch (...)
+			{
+				std::lock_guard<std::mutex> lock(doneM);
+				if (!error)
+					error = std::current_exception();
+			}
+			// Decremented and notified under doneM: once the caller sees 0
+			// it may return and destroy doneM, doneCv and error
+			std::lock_guard<std::mutex> lock(doneM);
+			if (--remaining == 0)
+				doneCv.notify_all();
+		});
+	}
+
+	// Help the workers while the chunks are not done
+	Task task;
+	while (remaining > 0 && pop(size(), task))
+		task();
+
+	std::unique_lock<std::mutex> lock(doneM);
+	doneCv.wait(lock, [&remaining]() {return remaining == 0;});
+	if (error)
+		std::rethrow_exception(error);
+}
+
+#endif
@@ -0,0 +1,131 @@
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+#include "classZeroFun.hpp"
+#include "AsyncSolver.hpp"
+using T = SolverTraits;
+
+// Benchmark of the asynchronous solves on a function with a high latency,
+// as a request to a remote service: every evaluation is answered after
+// latency by a single service thread, whatever the number of requests in
+// flight. The same problems are solved one after the other with Bisection,
+// waiting for every value, then interleaved on the event loop with
+// AsyncMultisection.
+
+// Service answering the requests after a fixed latency
+class LatencyService
+{
+public:
+	explicit LatencyService(std::chrono::microseconds latency_) : latency(latency_), worker([this]() {serve();}) {}
+
+	~LatencyService()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m);
+			stop = true;
+		}
+		cv.notify_all();
+		worker.join();
+	}
+
+	// Value of f at x, available after the latency
+	std::future<T::Real> request(const T::Real& x)
+	{
+		Request r{std::chrono::steady_clock::now() + latency, x, std::make_shared<std::promise<T::Real>>()};
+		std::future<T::Real> value = r.promise->get_future();
+		{
+			std::lock_guard<std::mutex> lock(m);
+			requests.push(r);
+		}
+		cv.notify_all();
+		return value;
+	}
+
+	static T::Real f(const T::Real& x) {return 0.5 - std::exp(M_PI * x);}
+
+private:
+	struct Request
+	{
+		std::chrono::steady_clock::time_point due;
+		T::Real x;
+		std::shared_ptr<std::promise<T::Real>> promise;
+
+		bool operator<(const Request& other) const {return due > other.due;}
+	};
+
+	std::chrono::microseconds latency;
+	std::priority_queue<Request> requests;
+	std::mutex m;
+	std::condition_variable cv;
+	bool stop{false};
+	std::thread worker;
+
+	void serve()
+	{
+		std::unique_lock<std::mutex> lock(m);
+		while (!stop)
+		{
+			if (requests.empty())
+			{
+				cv.wait(lock);
+				continue;
+			}
+			const Request r = requests.top();
+			if (std::chrono::steady_clock::now() < r.due)
+			{
+				cv.wait_until(lock, r.due);
+				continue;
+			}
+			requests.pop();
+			r.promise->set_value(f(r.x));
+		}
+	}
+};
+
+int main()
+{
+	constexpr unsigned int nProblems = 200;
+	constexpr T::Real tol = 1e-6;
+	const std::chrono::microseconds latency(1000);
+	LatencyService service(latency);
+	const T::AsyncFunType remote = [&service](const T::Real& x) {return service.request(x);};
+	// Blocking evaluation, the synchronous solvers wait for every value
+	const T::FunType blocking = [&remote](const T::Real& x) {return remote(x).get();};
+
+	std::cout << "Solves: " << nProblems << ", latency of f: " << latency.count() << " us, tol: " << tol << std::endl;
+
+	auto start = std::chrono::steady_clock::now();
+	std::size_t evals{0u};
+	for (unsigned int i = 0; i < nProblems; ++i)
+	{
+		const SolveStats s = Bisection(blocking, -1. - 0.001 * i, 1., tol).solveWithStats();
+		evals += s.fEvals;
+	}
+	double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	std::cout << "Bisection, sequential:      " << elapsed << " s, " << evals << " evaluations" << std::endl;
+
+	for (unsigned int k : {2u, 4u, 16u})
+	{
+		AsyncSolveLoop loop;
+		for (unsigned int i = 0; i < nProblems; ++i)
+			loop.add(std::make_unique<AsyncMultisection>(remote, -1. - 0.001 * i, 1., tol, k));
+		start = std::chrono::steady_clock::now();
+		const std::vector<SolveStats> stats = loop.run();
+		elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		evals = 0u;
+		T::Real error{0.};
+		for (const SolveStats& s : stats)
+		{
+			evals += s.fEvals;
+			error = std::max(error, std::abs(s.zero - std::log(0.5) / M_PI));
+		}
+		std::cout << "AsyncMultisection, k = " << k << (k < 10 ? ":  " : ": ") << elapsed << " s, " << evals << " evaluations, max error " << error << std::endl;
+	}
+	return 0;
+}
@@ -0,0 +1,69 @@
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include "ParallelSolveDriver.hpp"
+#include "SolverBatch.hpp"
+using T = SolverTraits;
+
+// Benchmark of the backends of ParallelSolveDriver on a batch of problems
+// of x^3 - 2x - 5 on the brackets [1 + 1e-6 i, 3] (Newton from 3): the
+// solvers of the factory, one per chunk, against the kernels of
+// DeviceBatchSolver on the CPU and, if built by nvcc (make gpu) with a
+// device, on the GPU. The GPU times include the copies to the device.
+
+// Test function, callable on the host and on the device
+struct Cubic
+{
+	ZEROFUN_HOST_DEVICE T::Real operator()(const T::Real& x, std::size_t) const {return (x * x - 2) * x - 5;}
+};
+
+struct CubicDerivative
+{
+	ZEROFUN_HOST_DEVICE T::Real operator()(const T::Real& x, std::size_t) const {return 3 * x * x - 2;}
+};
+
+int main()
+{
+	constexpr std::size_t nProblems = 1 << 18;
+	const T::Real zero = 2.0945514815423265;
+
+	Arena arena;
+	ProblemBatch problems(arena);
+	for (std::size_t i = 0; i < nProblems; ++i)
+		problems.push_back({1. + 1e-6 * i, 3., 3.}, 1e-10);
+	ResultBatch results(arena);
+
+	SolverFunctions fs;
+	fs.f = [](const T::Real& x) {return Cubic()(x, 0);};
+	fs.df = [](const T::Real& x) {return CubicDerivative()(x, 0);};
+	SolverParameters p;
+	p.tol = 1e-10;
+	p.tola = 1e-12;
+	p.maxIt = 100;
+
+	ParallelSolveDriver driver;
+	std::cout << "Problems: " << nProblems << ", threads: " << driver.threadPool().size() << std::endl;
+
+	// Runs a solve of the batch and reports its time and the error of the zeros
+	auto run = [&](const std::string& name, const auto& solve)
+	{
+		const auto start = std::chrono::steady_clock::now();
+		const bool ok = solve();
+		const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		T::Real error{0.};
+		for (std::size_t i = 0; i < results.size(); ++i)
+			error = std::max(error, std::abs(results.zero()[i] - zero));
+		std::cout << name << std::string(name.size() < 24 ? 24 - name.size() : 1, ' ') << (ok ? "" : "FAILED ") << elapsed * 1e9 / nProblems << " ns/solve, "
+			<< results.converged() << " converged, max error " << error << std::endl;
+	};
+
+	for (const std::string method : {"Bisection", "Brent", "Newton"})
+	{
+		run(method + ", solvers:", [&]() {return driver.solve(method, fs, p, problems, results);});
+		run(method + ", CPU kernels:", [&]() {return driver.solve(BatchBackend::Cpu, method, Cubic(), CubicDerivative(), p, problems, results);});
+		if (DeviceBatchSolver::gpuAvailable())
+			run(method + ", GPU kernels:", [&]() {return driver.solve(BatchBackend::Gpu, method, Cubic(), CubicDerivative(), p, problems, results);});
+	}
+	return 0;
+}
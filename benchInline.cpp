@@ -0,0 +1,105 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <vector>
+#include "classZeroFun.hpp"
+#include "BatchSolver.hpp"
+using T = SolverTraits;
+
+// Benchmark of the type-erased solvers (std::function) against the ones
+// templated on the type of the function (inlined lambda), then of the
+// inlined solvers in a loop against BatchSolver on the same problems
+
+// Average time in ns of one call of run(i) over n calls
+template<class Run>
+double timeSolve(const Run& run, const unsigned int& n)
+{
+	volatile T::Real sink{0.};
+	const auto start = std::chrono::steady_clock::now();
+	for (unsigned int i = 0; i < n; ++i)
+		sink = sink + run(i);
+	const auto end = std::chrono::steady_clock::now();
+	return std::chrono::duration<double, std::nano>(end - start).count() / n;
+}
+
+// Print the time of the two paths for a method
+void report(const std::string& method, const double& erased, const double& inlined)
+{
+	std::cout << method << ":\tstd::function " << erased << " ns/solve,\tinlined " << inlined << " ns/solve,\tspeedup " << erased / inlined << std::endl;
+}
+
+// Average time in ns of one solve of the n solved together by run()
+template<class Run>
+double timeBatch(const Run& run, const unsigned int& n)
+{
+	const auto start = std::chrono::steady_clock::now();
+	run();
+	const auto end = std::chrono::steady_clock::now();
+	return std::chrono::duration<double, std::nano>(end - start).count() / n;
+}
+
+// Print the time of the scalar loop and of the batch for a method, with the lanes of the batch that failed
+void reportBatch(const std::string& method, const double& scalar, const double& batched, const std::vector<T::Real>& x)
+{
+	const auto failed = std::count_if(x.begin(), x.end(), [](const T::Real& v) {return std::isnan(v);});
+	std::cout << method << ":\tloop " << scalar << " ns/solve,\tBatchSolver " << batched << " ns/solve,\tspeedup " << scalar / batched << ",\tfailed " << failed << std::endl;
+}
+
+int main()
+{
+	constexpr unsigned int n = 200000;
+	constexpr T::Real tol = 1e-10;
+	constexpr T::Real tola = 1e-12;
+	constexpr unsigned int maxIt = 150;
+
+	// Cheap function, so that the cost of the calls dominates; the parameter
+	// changes with i so that the solves cannot be hoisted out of the loop
+	auto fun = [](const T::Real& x, const unsigned int& i) {return 0.5 + 1e-7 * i - std::exp(M_PI * x);};
+	auto dfun = [](const T::Real& x) {return - M_PI * std::exp(M_PI * x);};
+
+	std::cout << "======== Benchmark: " << n << " solves per method ========\n" << std::endl;
+
+	report("Bisection",
+		timeSolve([&](unsigned int i) {return Bisection([&](const T::Real& x) {return fun(x, i);}, -1., 1., tol).solve();}, n),
+		timeSolve([&](unsigned int i) {return BasicBisection([&](const T::Real& x) {return fun(x, i);}, -1., 1., tol).solve();}, n));
+
+	report("Brent",
+		timeSolve([&](unsigned int i) {return Brent([&](const T::Real& x) {return fun(x, i);}, -1., 1., tol, maxIt).solve();}, n),
+		timeSolve([&](unsigned int i) {return BasicBrent([&](const T::Real& x) {return fun(x, i);}, -1., 1., tol, maxIt).solve();}, n));
+
+	report("Secant",
+		timeSolve([&](unsigned int i) {return Secant([&](const T::Real& x) {return fun(x, i);}, -0.3, -0.1, tol, tola, maxIt).solve();}, n),
+		timeSolve([&](unsigned int i) {return BasicSecant([&](const T::Real& x) {return fun(x, i);}, -0.3, -0.1, tol, tola, maxIt).solve();}, n));
+
+	report("Newton",
+		timeSolve([&](unsigned int i) {return Newton([&](const T::Real& x) {return fun(x, i);}, dfun, 0., tol, tola, maxIt).solve();}, n),
+		timeSolve([&](unsigned int i) {return BasicNewton([&](const T::Real& x) {return fun(x, i);}, dfun, 0., tol, tola, maxIt).solve();}, n));
+
+	std::cout << "\n======== Benchmark: " << n << " problems, BatchSolver with " << BatchSolver::Lanes << " lanes ========\n" << std::endl;
+
+	const BatchSolver batch(tol, tola, maxIt);
+	// The regula falsi takes about 240 iterations here, the scalar one has no maximum
+	const BatchSolver slowBatch(tol, tola, 1000);
+	auto kernel = [&fun](const T::Real& x, const std::size_t& i) {return fun(x, static_cast<unsigned int>(i));};
+	auto dkernel = [&dfun](const T::Real& x, const std::size_t&) {return dfun(x);};
+	std::vector<T::Real> a(n, -1.), b(n, 1.), a0(n, -0.3), b0(n, -0.1), x0(n, 0.), x(n);
+
+	reportBatch("Bisection",
+		timeSolve([&](unsigned int i) {return BasicBisection([&](const T::Real& y) {return fun(y, i);}, -1., 1., tol).solve();}, n),
+		timeBatch([&]() {batch.bisection(kernel, a.data(), b.data(), x.data(), n);}, n), x);
+
+	reportBatch("RegulaFalsi",
+		timeSolve([&](unsigned int i) {return BasicRegulaFalsi([&](const T::Real& y) {return fun(y, i);}, -1., 1., tol, tola).solve();}, n),
+		timeBatch([&]() {slowBatch.regulaFalsi(kernel, a.data(), b.data(), x.data(), n);}, n), x);
+
+	reportBatch("Secant",
+		timeSolve([&](unsigned int i) {return BasicSecant([&](const T::Real& y) {return fun(y, i);}, -0.3, -0.1, tol, tola, maxIt).solve();}, n),
+		timeBatch([&]() {batch.secant(kernel, a0.data(), b0.data(), x.data(), n);}, n), x);
+
+	reportBatch("Newton",
+		timeSolve([&](unsigned int i) {return BasicNewton([&](const T::Real& y) {return fun(y, i);}, dfun, 0., tol, tola, maxIt).solve();}, n),
+		timeBatch([&]() {batch.newton(kernel, dkernel, x0.data(), x.data(), n);}, n), x);
+
+	return 0;
+}
@@ -0,0 +1,249 @@
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "classZeroFun.hpp"
+#include "SolverFactory.hpp"
+#include "Continuation.hpp"
+#include "RootScanner.hpp"
+#include "CachedFunction.hpp"
+#include "AutoSolver.hpp"
+using T = SolverTraits;
+
+// Benchmark of all the solvers on a standard set of test functions.
+// For every method and function it reports the time per solve (with the
+// construction of the solver), the evaluations of f and df per solve and
+// the error on the zero. The number of repetitions is increased until a
+// run lasts at least minTime seconds, as done by Google Benchmark.
+// Then a parameter sweep is solved cold, one new solver per parameter,
+// and with Continuation, reporting the iterations and evaluations per solve,
+// all the zeros of sin in an interval are found by findAllRoots, and the
+// hit rate of a CachedFunction is reported for a few uses.
+
+// Test function with its derivative and its exact zero
+struct TestFunction
+{
+	std::string name;
+	T::FunType f;
+	T::FunType df;
+	T::FunType d2f;
+	// f on dual numbers, for AutoDiffNewton
+	T::DualFunType fd;
+	T::Real zero;
+};
+
+// Creates a solver of the given method for the test function
+using SolverMaker = std::function<std::unique_ptr<SolverBase>(const TestFunction&)>;
+
+// Number of terms of the costly function
+constexpr unsigned int costlyTerms = 2000;
+
+// The functions are generic, so that they can be evaluated on dual numbers
+std::vector<TestFunction> testFunctions()
+{
+	using std::cosh, std::exp, std::pow, std::tanh;
+	// Smooth, simple zero
+	auto smooth = [](const auto& x) {return 0.5 - exp(M_PI * x);};
+	// Stiff, steep transition around the zero
+	auto stiff = [](const auto& x) {return tanh(50. * (x - 0.3));};
+	// Triple zero
+	auto multiple = [](const auto& x) {return pow(x - 0.3, 3);};
+	// Flat near the zero, all the derivatives vanish
+	auto flat = [](const auto& x) {return x == 0.3 ? 0. * x : (x - 0.3) * exp(-1. / pow(x - 0.3, 2));};
+	// Costly to evaluate, sum of exponentials
+	auto costly = [](const auto& x)
+	{
+		auto sum = 0. * x;
+		for (unsigned int k = 1; k <= costlyTerms; ++k)
+			sum += exp(k * (x - 0.3) / costlyTerms);
+		return sum / costlyTerms - 1.;
+	};
+
+	return {
+		{"smooth", smooth, [](const T::Real& x) {return - M_PI * std::exp(M_PI * x);},
+			[](const T::Real& x) {return - M_PI * M_PI * std::exp(M_PI * x);}, smooth, std::log(0.5) / M_PI},
+		{"stiff", stiff, [](const T::Real& x) {return 50. / std::pow(std::cosh(50. * (x - 0.3)), 2);},
+			[](const T::Real& x) {return -5000. * std::tanh(50. * (x - 0.3)) / std::pow(std::cosh(50. * (x - 0.3)), 2);}, stiff, 0.3},
+		{"multiple", multiple, [](const T::Real& x) {return 3. * std::pow(x - 0.3, 2);},
+			[](const T::Real& x) {return 6. * (x - 0.3);}, multiple, 0.3},
+		{"flat", flat, [](const T::Real& x) {const T::Real d = x - 0.3; return d == 0. ? 0. : std::exp(-1. / (d * d)) * (1. + 2. / (d * d));},
+			[](const T::Real& x) {const T::Real d = x - 0.3; return d == 0. ? 0. : std::exp(-1. / (d * d)) * (4. / std::pow(d, 5) - 2. / std::pow(d, 3));}, flat, 0.3},
+		{"costly", costly, [](const T::Real& x)
+			{
+				T::Real sum{0.};
+				for (unsigned int k = 1; k <= costlyTerms; ++k)
+					sum += k * std::exp(k * (x - 0.3) / costlyTerms) / costlyTerms;
+				return sum / costlyTerms;
+			},
+			[](const T::Real& x)
+			{
+				T::Real sum{0.};
+				for (unsigned int k = 1; k <= costlyTerms; ++k)
+					sum += std::pow(static_cast<T::Real>(k) / costlyTerms, 2) * std::exp(k * (x - 0.3) / costlyTerms);
+				return sum / costlyTerms;
+			}, costly, 0.3}
+	};
+}
+
+int main()
+{
+	constexpr T::Real a = -1.;
+	constexpr T::Real b = 1.;
+	constexpr T::Real x0 = 0.;
+	constexpr T::Real tol = 1e-8;
+	constexpr T::Real tola = 1e-12;
+	constexpr T::Real h = 1e-4;
+	constexpr unsigned int maxIt = 200;
+	constexpr double minTime = 0.05;
+
+	const SolverFactory factory;
+	const std::vector<std::pair<std::string, SolverMaker>> methods = {
+		{"RegulaFalsi", [&](const TestFunction& t) {return factory.make_solver<RegulaFalsi>(t.f, a, b, tol, tola);}},
+		{"Illinois", [&](const TestFunction& t) {return factory.make_solver<ModifiedRegulaFalsi>(t.f, a, b, tol, tola, maxIt, SideScaling::Illinois);}},
+		{"AndersonBjorck", [&](const TestFunction& t) {return factory.make_solver<ModifiedRegulaFalsi>(t.f, a, b, tol, tola, maxIt, SideScaling::AndersonBjorck);}},
+		{"Bisection", [&](const TestFunction& t) {return factory.make_solver<Bisection>(t.f, a, b, tol);}},
+		{"Multisection", [&](const TestFunction& t) {return factory.make_solver<Multisection>(t.f, a, b, tol, 4u, &ThreadPool::shared());}},
+		{"Secant", [&](const TestFunction& t) {return factory.make_solver<Secant>(t.f, a, b, tol, tola, maxIt);}},
+		{"Brent", [&](const TestFunction& t) {return factory.make_solver<Brent>(t.f, a, b, tol, maxIt);}},
+		{"Newton", [&](const TestFunction& t) {return factory.make_solver<Newton>(t.f, t.df, x0, tol, tola, maxIt);}},
+		{"SafeNewton", [&](const TestFunction& t) {return factory.make_solver<SafeNewton>(t.f, t.df, a, b, tol, tola, maxIt);}},
+		{"Halley", [&](const TestFunction& t) {return factory.make_solver<Halley>(t.f, t.df, t.d2f, x0, tol, tola, maxIt);}},
+		{"Steffensen", [&](const TestFunction& t) {return factory.make_solver<Steffensen>(t.f, x0, tol, tola, maxIt);}},
+		{"QuasiNewton", [&](const TestFunction& t) {return factory.make_solver<QuasiNewton>(t.f, x0, h, tol, tola, maxIt);}},
+		{"QuasiNewton-Forward", [&](const TestFunction& t) {return factory.make_solver<QuasiNewton>(t.f, x0, h, tol, tola, maxIt, SlopeUpdate::Forward);}},
+		{"QuasiNewton-Secant", [&](const TestFunction& t) {return factory.make_solver<QuasiNewton>(t.f, x0, h, tol, tola, maxIt, SlopeUpdate::Secant);}},
+		{"QuasiNewton-Chord", [&](const TestFunction& t) {return factory.make_solver<QuasiNewton>(t.f, x0, h, tol, tola, maxIt, SlopeUpdate::Chord);}},
+		{"AutoDiffNewton", [&](const TestFunction& t) {return factory.make_solver<AutoDiffNewton>(t.fd, x0, tol, tola, maxIt);}}
+	};
+
+	std::cout << std::left << std::setw(28) << "Benchmark" << std::right
+		<< std::setw(14) << "ns/solve" << std::setw(12) << "f-evals" << std::setw(12) << "df-evals"
+		<< std::setw(14) << "error" << std::setw(12) << "solves" << '\n'
+		<< std::string(92, '-') << '\n';
+
+	for (const auto& t : testFunctions())
+		for (const auto& [name, make] : methods)
+		{
+			SolveStats stats;
+			unsigned long n = 1;
+			double elapsed = 0.;
+			while (true)
+			{
+				const auto start = std::chrono::steady_clock::now();
+				for (unsigned long i = 0; i < n; ++i)
+					stats = make(t)->solveWithStats();
+				elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+				if (elapsed >= minTime)
+					break;
+				n *= 2;
+			}
+
+			std::cout << std::left << std::setw(28) << (name + "/" + t.name) << std::right
+				<< std::setw(14) << std::fixed << std::setprecision(1) << 1e9 * elapsed / n
+				<< std::setw(12) << stats.fEvals << std::setw(12) << stats.dfEvals
+				<< std::setw(14) << std::scientific << std::setprecision(2);
+			if (stats.ok())
+				std::cout << std::abs(stats.zero - t.zero);
+			else
+				std::cout << "failed";
+			std::cout << std::setw(12) << n << '\n';
+		}
+
+	// Sweep of exp(x) - p x - 2 = 0 for p in [0, 1), zeros in [0.89, 1.15]
+	constexpr unsigned int nSweep = 100;
+	auto g = [](const T::Real& x, const T::Real& p) {return std::exp(x) - p * x - 2.;};
+	auto dg = [](const T::Real& x, const T::Real& p) {return std::exp(x) - p;};
+	// Prints the mean iterations and evaluations of the sweep solved by solve(p)
+	auto sweep = [&](const std::string& name, const auto& solve)
+	{
+		unsigned long iterations{0}, fEvals{0}, dfEvals{0}, failed{0};
+		for (unsigned int k = 0; k < nSweep; ++k)
+		{
+			const SolveStats s = solve(static_cast<T::Real>(k) / nSweep);
+			iterations += s.iterations;
+			fEvals += s.fEvals;
+			dfEvals += s.dfEvals;
+			failed += !s.ok();
+		}
+		std::cout << std::left << std::setw(28) << name << std::right << std::fixed << std::setprecision(1)
+			<< std::setw(14) << static_cast<double>(iterations) / nSweep << std::setw(12) << static_cast<double>(fEvals) / nSweep
+			<< std::setw(12) << static_cast<double>(dfEvals) / nSweep << std::setw(12) << failed << '\n';
+	};
+
+	std::cout << "\n" << std::left << std::setw(28) << "Sweep of " + std::to_string(nSweep) + " problems" << std::right
+		<< std::setw(14) << "iterations" << std::setw(12) << "f-evals" << std::setw(12) << "df-evals" << std::setw(12) << "failed" << '\n'
+		<< std::string(78, '-') << '\n';
+	sweep("Brent, cold", [&](const T::Real& p) {return Brent([&](const T::Real& x) {return g(x, p);}, 0., 2., tol, maxIt).solveWithStats();});
+	const std::pair<std::string, ContinuationOrder> orders[] = {{"Constant", ContinuationOrder::Constant}, {"Linear", ContinuationOrder::Linear}, {"Quadratic", ContinuationOrder::Quadratic}};
+	for (const auto& [name, order] : orders)
+	{
+		Continuation continuation(g, 0., 2., tol, maxIt, order);
+		sweep("Brent, " + name, [&](const T::Real& p) {return continuation.solveWithStats(p);});
+	}
+	sweep("Newton, cold", [&](const T::Real& p) {return Newton([&](const T::Real& x) {return g(x, p);}, [&](const T::Real& x) {return dg(x, p);}, 0., tol, tola, maxIt).solveWithStats();});
+	for (const auto& [name, order] : orders)
+	{
+		Continuation continuation(g, dg, 0., tol, tola, maxIt, order);
+		sweep("Newton, " + name, [&](const T::Real& p) {return continuation.solveWithStats(p);});
+	}
+
+	// The 19 zeros k pi of sin in [0.5, 20 pi - 0.5], the evaluations counted across the threads
+	constexpr std::size_t nScan = 200;
+	std::atomic<std::size_t> scanEvals{0};
+	auto wave = [&scanEvals](const T::Real& x) {++scanEvals; return std::sin(x);};
+	const std::vector<T::Real> roots = findAllRoots(wave, 0.5, 20 * M_PI - 0.5, nScan, tol);
+	T::Real scanError{0.};
+	for (std::size_t k = 0; k < roots.size(); ++k)
+		scanError = std::max(scanError, std::abs(roots[k] - (k + 1) * M_PI));
+	std::cout << "\nfindAllRoots of sin on " << nScan << " subintervals: " << roots.size() << " zeros (19 expected), "
+		<< std::defaultfloat << scanEvals.load() - (nScan + 1) << " evaluations after the " << nScan + 1 << " samples, max error " << scanError << '\n';
+
+	// Calls answered by the cache of the smooth function
+	const TestFunction smooth = testFunctions().front();
+	auto cacheHits = [](const std::string& name, const CachedFunction<T>& cached)
+	{
+		std::cout << std::left << std::setw(44) << name << std::right << std::setw(6) << cached.hits() << " hits of " << std::setw(4) << cached.hits() + cached.evaluations()
+			<< " calls, " << std::fixed << std::setprecision(1) << 100. * cached.hits() / (cached.hits() + cached.evaluations()) << "%\n";
+	};
+	std::cout << "\nCachedFunction on the smooth function\n";
+	{
+		CachedFunction<T> cached(smooth.f);
+		QuasiNewton(cached, x0, h, tol, tola, maxIt).solve();
+		cacheHits("QuasiNewton, Central slope", cached);
+	}
+	{
+		CachedFunction<T> cached(smooth.f);
+		Brent(cached, 1., 2., tol, maxIt).solve();
+		cacheHits("Brent, search of a bracket from [1, 2]", cached);
+	}
+	{
+		CachedFunction<T> cached(smooth.f);
+		SolverFunctions fs;
+		fs.f = cached;
+		SolverParameters p;
+		p.a = a;
+		p.b = b;
+		p.tol = tol;
+		p.maxIt = maxIt;
+		// Own history, so that Auto picks its first candidate
+		AutoHistory history;
+		AutoSolver(fs, p, history).solve();
+		cacheHits("Auto, probes at a and b", cached);
+	}
+	{
+		CachedFunction<T> cached(smooth.f);
+		Brent brent(cached, a, b, tol, maxIt);
+		for (unsigned int k = 0; k < 10; ++k)
+			brent.solve(SolverProblem{a, b, x0});
+		cacheHits("Brent, the same problem solved 10 times", cached);
+	}
+
+	std::cout << "\nQuasiNewton counts in f-evals also the evaluations of its differences (three per iteration with the Central slope),"
+		<< "\nAutoDiffNewton evaluates f and df together on a dual number" << std::endl;
+
+	return 0;
+}
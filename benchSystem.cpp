@@ -0,0 +1,67 @@
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include "NewtonSystem.hpp"
+using T = SolverTraits;
+
+// Benchmark of NewtonSystem on the intersection of the circle
+// x^2 + y^2 = 4 with the curve y = 1 - exp(x), from (1, -1): every
+// JacobianUpdate, with the exact Jacobian and with its forward difference,
+// whose evaluations of f are counted in f-evals. For every variant it
+// reports the time per solve, the iterations, the evaluations of f and of
+// the Jacobian, the factorizations and the final residual.
+
+constexpr std::size_t N = 2;
+using Vector = SystemVector<T::Real, N>;
+using Matrix = SystemMatrix<T::Real, N>;
+
+// Time per solve in ns over n solves, and the statistics of the last one
+template<class Solver>
+void run(const std::string& name, Solver& solver, const unsigned int& n)
+{
+	BasicSystemSolveStats<T, N> s;
+	const auto start = std::chrono::steady_clock::now();
+	for (unsigned int i = 0; i < n; ++i)
+		s = solver.solveWithStats();
+	const double elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / n;
+	std::cout << std::left << std::setw(30) << name << std::right << std::fixed << std::setprecision(1) << std::setw(12) << elapsed
+		<< std::setw(8) << s.iterations << std::setw(9) << s.fEvals << std::setw(9) << s.jacobianEvals << std::setw(9) << s.factorizations
+		<< std::scientific << std::setprecision(2) << std::setw(12) << s.residual << (s.ok() ? "" : "  FAILED") << '\n';
+}
+
+int main()
+{
+	constexpr unsigned int n = 100000;
+	constexpr T::Real tol = 1e-12;
+	constexpr T::Real tola = 1e-14;
+	constexpr unsigned int maxIt = 100;
+	const Vector x0{1., -1.};
+
+	auto f = [](const Vector& x) {return Vector{x[0] * x[0] + x[1] * x[1] - 4., std::exp(x[0]) + x[1] - 1.};};
+	auto jac = [](const Vector& x) {return Matrix{{{2. * x[0], 2. * x[1]}, {std::exp(x[0]), 1.}}};};
+
+	std::cout << std::left << std::setw(30) << "Variant" << std::right << std::setw(12) << "ns/solve" << std::setw(8) << "iter"
+		<< std::setw(9) << "f-evals" << std::setw(9) << "J-evals" << std::setw(9) << "LU" << std::setw(12) << "residual" << '\n'
+		<< std::string(89, '-') << '\n';
+
+	const std::pair<std::string, unsigned int> refreshes[] = {{"Newton", 1u}, {"Shamanskii, refresh = 3", 3u}, {"chord", 0u}};
+	for (const auto& [name, refresh] : refreshes)
+	{
+		BasicNewtonSystem<T, N, decltype(f), decltype(jac)> solver(f, jac, x0, tol, tola, maxIt, JacobianUpdate::Newton, refresh);
+		run(name, solver, n);
+	}
+	BasicNewtonSystem<T, N, decltype(f), decltype(jac)> broyden(f, jac, x0, tol, tola, maxIt, JacobianUpdate::Broyden);
+	run("Broyden", broyden, n);
+
+	const ForwardDifferenceJacobian<T, N, decltype(f)> difference{f, 1e-7};
+	ForwardDifferenceNewtonSystem<N, decltype(f)> newtonDifference(f, difference, x0, tol, tola, maxIt);
+	run("Newton, forward difference", newtonDifference, n);
+	ForwardDifferenceNewtonSystem<N, decltype(f)> broydenDifference(f, difference, x0, tol, tola, maxIt, JacobianUpdate::Broyden);
+	run("Broyden, forward difference", broydenDifference, n);
+
+	const Vector zero = newtonDifference.solve();
+	std::cout << "\nZero: (" << std::setprecision(15) << std::fixed << zero[0] << ", " << zero[1] << ")" << std::endl;
+	return 0;
+}
@@ -2,184 +2,898 @@
 #define _CLASS_ZERO_FUN_HPP_
 
 #include "SolverTraits.hpp"
+#include "SolveStats.hpp"
+#include "SolverParameters.hpp"
+#include "StoppingPolicy.hpp"
+#include "SolverTrace.hpp"
+#include "Logger.hpp"
+#include "ThreadPool.hpp"
+#include <chrono>
 #include <cmath>
 #include <limits>
 #include <tuple>
+#include <type_traits>
+#include <vector>
+
+/*
+ * The solvers are class templates on the traits and on the type F of the
+ * function (and DF of the derivative for Newton). With the default
+ * F = Traits::FunType (a std::function) we get the usual type-erased
+ * solvers, aliased below as RegulaFalsi, Bisection, ... and compiled in
+ * libclassZeroFun.so. Passing the type of a lambda instead lets the
+ * compiler inline every call to f in the solve loops, e.g.
+ *
+ *   BasicBrent brent(fun, a, b, tol, maxIt); // F = decltype(fun)
+ *
+ * A solver can be reused for many problems without building a new one:
+ * reset(params) changes all its parameters, solve(problem) only the
+ * interval or the starting point, e.g. for a pool of solvers. solve()
+ * keeps its iterate and bracket in locals, so solving again gives the
+ * same result.
+ */
+
+// Keeps the branch it is put in as a jump. With f inlined, GCC turns the
+// update of a bracket into a select on the sign of f, so the next point
+// waits for f instead of being computed ahead by the predicted branch
+#if defined(__GNUC__)
+#define ZEROFUN_KEEP_BRANCH() __asm__("")
+#else
+#define ZEROFUN_KEEP_BRANCH()
+#endif
 
 /* * * * * * * * *
  *  Base class	 *
  * * * * * * * * */
-class SolverBase
+template<class Traits, class F = typename Traits::FunType>
+class BasicSolverBase
 {
 public:
-	using T = SolverTraits;
-	
-	SolverBase(const T::FunType& f_, const double& tol_) : f(f_), tol(tol_) {}
+	using T = Traits;
+	using Real = typename T::Real;
+
+	BasicSolverBase(const F& f_, const Real& tol_) : f(f_), tol(tol_) {}
 
-	virtual T::Real solve() = 0;
-		
-	virtual ~SolverBase() = default;
+	using Parameters = BasicSolverParameters<Traits>;
+	using Problem = BasicSolverProblem<Traits>;
+
+	virtual Real solve() = 0;
+
+	// Solves the given problem with the current parameters
+	Real solve(const Problem& problem)
+	{
+		setProblem(problem);
+		return solve();
+	}
+
+	// Solves and returns the zero together with the statistics of the solve
+	BasicSolveStats<Traits> solveWithStats();
+
+	// Solves the given problem, with the statistics of the solve
+	BasicSolveStats<Traits> solveWithStats(const Problem& problem)
+	{
+		setProblem(problem);
+		return solveWithStats();
+	}
+
+	// Changes all the parameters, the object is as if built with them
+	virtual void reset(const Parameters& p)
+	{
+		tol = p.tol;
+		stats = BasicSolveStats<Traits>();
+		lastStatus = SolveStatus::NotSolved;
+	}
+
+	// Changes the problem: the interval or the starting point
+	virtual void setProblem(const Problem& problem) = 0;
+
+	// Outcome of the last solve
+	SolveStatus status() const {return lastStatus;}
+
+	// Adds a stopping policy to the criterion of the method
+	void setStoppingPolicy(const BasicStoppingPolicy<Traits>& policy_)
+	{
+		policy = policy_;
+		usePolicy = policy.active();
+	}
+
+	// Changes the function, so that the object can be reused for a new problem
+	// (not virtual, it is instantiated only if F can be assigned)
+	void setFunction(const F& f_)
+	{
+		f = f_;
+		functionChanged();
+	}
+
+	virtual ~BasicSolverBase() = default;
 
 protected:
-	// Function 
-	T::FunType f;
-	// Tolerance 
-	T::Real tol;
+	// Function
+	F f;
+	// Tolerance
+	Real tol;
+	// Statistics, the counters include the evaluations done by the constructor
+	BasicSolveStats<Traits> stats;
+	// True while solving with solveWithStats, enables the per-iteration records
+	bool collect{false};
+	// Outcome of the last solve
+	SolveStatus lastStatus{SolveStatus::NotSolved};
+	// Stopping policy, used if active
+	BasicStoppingPolicy<Traits> policy;
+	bool usePolicy{false};
+	// Outcome given by the policy when it stops the solve
+	SolveStatus policyStatus{SolveStatus::NotSolved};
+	// Start of the solve and evaluations done before it, for the limits of the policy
+	std::chrono::steady_clock::time_point policyStart;
+	std::size_t policyEvals{0u};
+	// Number of the solve in the trace of the thread (with ZEROFUN_TRACE)
+	std::uint64_t traceSolve{0u};
+
+	// Called by setFunction after the function has been changed
+	virtual void functionChanged() {}
+
+	// Evaluates f, counting the call
+	Real evalF(const Real& x)
+	{
+		++stats.fEvals;
+		return f(x);
+	}
+
+	// Called at the start of every solve, starts the limits of the policy
+	void beginSolve()
+	{
+		if constexpr (traceEnabled)
+			traceSolve = BasicSolverTrace<Real>::local().begin();
+		if (usePolicy)
+		{
+			policyEvals = stats.fEvals + stats.dfEvals;
+			if (policy.deadline > 0)
+				policyStart = std::chrono::steady_clock::now();
+		}
+	}
+
+	// Called, if usePolicy, at the end of every iteration that would go on:
+	// true if the policy stops the solve at x, after the step dx, with f(x) = fx
+	bool checkPolicy(const Real& x, const Real& dx, const Real& fx);
+
+	// Records an iteration in the trace of the thread, compiled away without ZEROFUN_TRACE
+	void trace(const char* method, const TraceStep& step, const unsigned int& iteration, const Real& x, const Real& fx,
+		const Real& a = std::numeric_limits<Real>::quiet_NaN(), const Real& b = std::numeric_limits<Real>::quiet_NaN()) const
+	{
+		if constexpr (traceEnabled)
+			BasicSolverTrace<Real>::local().record(traceSolve, method, iteration, step, x, fx, a, b);
+	}
+
+	// Stores the final state of a solve
+	void setStats(const SolveStatus& status, const unsigned int& iterations, const Real& residual, const Real& bracketWidth = std::numeric_limits<Real>::quiet_NaN())
+	{
+		lastStatus = status;
+		stats.status = status;
+		stats.iterations = iterations;
+		stats.residual = residual;
+		stats.bracketWidth = bracketWidth;
+	}
 
 };
 
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
  * Base class for solvers that rely on an interval to find the zero  *
  * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
-class SolverWithInterval : public SolverBase
+template<class Traits, class F = typename Traits::FunType>
+class BasicSolverWithInterval : public BasicSolverBase<Traits, F>
 {
 public:
+	using typename BasicSolverBase<Traits, F>::Real;
+
 	// Constructor for when the interval extremes are provided by the user
-	SolverWithInterval(const T::FunType& f_, const T::Real& a_, const T::Real& b_, const T::Real& tol_, const T::Real& h_interval_, const unsigned int& maxIter_) : 
-		SolverBase(f_, tol_), a(a_), b(b_), x1((a_ + b_) / 2.), h_interval(h_interval_), maxIter(maxIter_) 
-	{
-		if (f(a) * f(b) > 0)
-		{
-			// If the interval is not valid, look for a valid one
-			std::cout << "The provided interval is not valid... Trying to find a valid one" << std::endl;
-
-			auto result = bracketInterval(f, x1, h_interval, maxIter);
-			if (std::get<2>(result))
-			{
-				// If valid interval was found initialize extremes
-				a = std::get<0>(result);
-				b = std::get<1>(result);
-			}
-			else 
-			{
-				std::cout << "Could not find an interval, the function has no zero. Interval will be set to [-Nan, Nan]" << std::endl;
-				a = -std::numeric_limits<T::Real>::quiet_NaN();
-				b = std::numeric_limits<T::Real>::quiet_NaN();
-			}
-		}
-	}
+	BasicSolverWithInterval(const F& f_, const Real& a_, const Real& b_, const Real& tol_, const Real& h_interval_, const unsigned int& maxIter_, const BracketStrategy& strategy_ = BracketStrategy::Linear);
+
+	// Changes the interval, searching a valid one if f does not change sign at the extremes
+	void setInterval(const Real& a_, const Real& b_);
+
+	// Changes all the parameters and the interval
+	void reset(const typename BasicSolverBase<Traits, F>::Parameters& p) override;
+
+	// Changes the interval
+	void setProblem(const typename BasicSolverBase<Traits, F>::Problem& problem) override {setInterval(problem.a, problem.b);}
+
+	// Changes the initial step of the search of a valid interval
+	void setBracketStep(const Real& h_interval_) {h_interval = h_interval_;}
+
+	// Interval of the problem, solve() works on a copy
+	Real lower() const {return a;}
+	Real upper() const {return b;}
+
+	virtual ~BasicSolverWithInterval() = default;
 
-	virtual ~SolverWithInterval() = default;
+protected:
+	using BasicSolverBase<Traits, F>::f;
+	using BasicSolverBase<Traits, F>::evalF;
+
+	// The current interval is checked again with the new function
+	void functionChanged() override {setInterval(a, b);}
 
-protected:	
 	// Interval lower bound
-	T::Real a;
+	Real a;
 	// Interval upper bound
-	T::Real b;
+	Real b;
+	// Value of the function at the lower bound
+	Real fa;
+	// Value of the function at the upper bound
+	Real fb;
 	// Initial guess for bracketInterval function
-	T::Real x1;
+	Real x1;
 	// Step to be used in the bracketInterval function
-	T::Real h_interval;
+	Real h_interval;
 	// Maximum number of iterations to be used in the bracketInterval function
-	T::Real maxIter;
+	Real maxIter;
+	// Strategy used by the bracketInterval function
+	BracketStrategy strategy;
 
 	// Function to find an interval that contains the zero
-	 std::tuple<T::Real, T::Real, bool> bracketInterval(const T::FunType &f, T::Real x1, T::Real h, unsigned int maxIter);
+	 std::tuple<Real, Real, bool> bracketInterval(Real x1, Real h, unsigned int maxIter);
+	// Strategies of bracketInterval
+	std::tuple<Real, Real, bool> bracketLinear(Real x1, Real h, unsigned int maxIter);
+	std::tuple<Real, Real, bool> bracketGolden(Real x1, Real h, unsigned int maxIter);
+	std::tuple<Real, Real, bool> bracketExtrapolation(Real x1, Real h, unsigned int maxIter);
 
 };
 
 /* * * * * * * * * * * *
  * Regula Falsi method *
  * * * * * * * * * * * */
-class RegulaFalsi final : public SolverWithInterval
+template<class Traits, class F = typename Traits::FunType>
+class BasicRegulaFalsi final : public BasicSolverWithInterval<Traits, F>
 {
 public:
+	using typename BasicSolverWithInterval<Traits, F>::Real;
+
 	// Constructor for when the interval is provided by the user
-	RegulaFalsi(const T::FunType& f_, const T::Real& a_, const T::Real& b_, const T::Real& tol_, const T::Real& tola_, const T::Real& h_interval_ = 0.01, const unsigned int& maxIter_ = 200) : 
-		SolverWithInterval(f_, a_, b_, tol_, h_interval_, maxIter_), tola(tola_) {}
+	BasicRegulaFalsi(const F& f_, const Real& a_, const Real& b_, const Real& tol_, const Real& tola_, const Real& h_interval_ = 0.01, const unsigned int& maxIter_ = 200, const BracketStrategy& strategy_ = BracketStrategy::Linear) :
+		BasicSolverWithInterval<Traits, F>(f_, a_, b_, tol_, h_interval_, maxIter_, strategy_), tola(tola_) {}
 
-	T::Real solve() override;
+	Real solve() override;
+	using BasicSolverWithInterval<Traits, F>::solve;
+
+	// Changes all the parameters and the interval
+	void reset(const typename BasicSolverWithInterval<Traits, F>::Parameters& p) override
+	{
+		tola = p.tola;
+		BasicSolverWithInterval<Traits, F>::reset(p);
+	}
 
 protected:
+	using BasicSolverWithInterval<Traits, F>::f;
+	using BasicSolverWithInterval<Traits, F>::tol;
+	using BasicSolverWithInterval<Traits, F>::a;
+	using BasicSolverWithInterval<Traits, F>::b;
+	using BasicSolverWithInterval<Traits, F>::fa;
+	using BasicSolverWithInterval<Traits, F>::fb;
+
 	// Absolute tolerance
-	T::Real tola;
+	Real tola;
 };
 
 /* * * * * * * * * * *
  * Bisection method  *
  * * * * * * * * * * */
-class Bisection final: public SolverWithInterval
+template<class Traits, class F = typename Traits::FunType>
+class BasicBisection final: public BasicSolverWithInterval<Traits, F>
 {
 public:
+	using typename BasicSolverWithInterval<Traits, F>::Real;
+
 	// Constructor used when interval extremes are provided by the user
-	Bisection(const T::FunType& f_, const T::Real& a_, const T::Real& b_, const T::Real& tol_, const T::Real& h_interval_ = 0.01, const unsigned int& maxIter_ = 200) : 
-		SolverWithInterval(f_, a_, b_, tol_, h_interval_, maxIter_) {}
+	BasicBisection(const F& f_, const Real& a_, const Real& b_, const Real& tol_, const Real& h_interval_ = 0.01, const unsigned int& maxIter_ = 200, const BracketStrategy& strategy_ = BracketStrategy::Linear) :
+		BasicSolverWithInterval<Traits, F>(f_, a_, b_, tol_, h_interval_, maxIter_, strategy_) {}
 
-	T::Real solve() override;	
+	Real solve() override;
+	using BasicSolverWithInterval<Traits, F>::solve;
 
+protected:
+	using BasicSolverWithInterval<Traits, F>::f;
+	using BasicSolverWithInterval<Traits, F>::tol;
+	using BasicSolverWithInterval<Traits, F>::a;
+	using BasicSolverWithInterval<Traits, F>::b;
+	using BasicSolverWithInterval<Traits, F>::fa;
+	using BasicSolverWithInterval<Traits, F>::fb;
+};
+
+/* * * * * * * * * * * *
+ * Multisection method *
+ * * * * * * * * * * * */
+/*!
+ * Bisection with k - 1 points per iteration: the points dividing [a, b]
+ * in k equal parts are evaluated together and the part where f changes
+ * sign is kept, gaining log2(k) bits per iteration instead of 1. With a
+ * pool of more than one worker the points are evaluated in parallel (f
+ * must then be thread safe), so that the time to reach tol drops by about
+ * log2(k) when f is costly; otherwise in a loop, vectorized for an inlined f.
+ */
+template<class Traits, class F = typename Traits::FunType>
+class BasicMultisection final: public BasicSolverWithInterval<Traits, F>
+{
+public:
+	using typename BasicSolverWithInterval<Traits, F>::Real;
+
+	// Constructor used when interval extremes are provided by the user, the pool may be null
+	BasicMultisection(const F& f_, const Real& a_, const Real& b_, const Real& tol_, const unsigned int& sections_ = 4, ThreadPool* pool_ = nullptr, const Real& h_interval_ = 0.01, const unsigned int& maxIter_ = 200, const BracketStrategy& strategy_ = BracketStrategy::Linear) :
+		BasicSolverWithInterval<Traits, F>(f_, a_, b_, tol_, h_interval_, maxIter_, strategy_), sections(std::max(2u, sections_)), pool(pool_) {}
+
+	Real solve() override;
+	using BasicSolverWithInterval<Traits, F>::solve;
+
+	// Changes all the parameters and the interval
+	void reset(const typename BasicSolverWithInterval<Traits, F>::Parameters& p) override
+	{
+		sections = std::max(2u, p.sections);
+		BasicSolverWithInterval<Traits, F>::reset(p);
+	}
+
+	// Changes the pool used for the evaluations (null evaluates on the calling thread)
+	void setPool(ThreadPool* pool_) {pool = pool_;}
+
+protected:
+	using BasicSolverWithInterval<Traits, F>::f;
+	using BasicSolverWithInterval<Traits, F>::tol;
+	using BasicSolverWithInterval<Traits, F>::a;
+	using BasicSolverWithInterval<Traits, F>::b;
+	using BasicSolverWithInterval<Traits, F>::fa;
+	using BasicSolverWithInterval<Traits, F>::fb;
+
+	// Number of parts of the interval at every iteration
+	unsigned int sections;
+	ThreadPool* pool;
+	// Points of an iteration and their values, kept to avoid allocations
+	std::vector<Real> xs;
+	std::vector<Real> ys;
 };
 
 /* * * * * * * * *
  * Secant method *
  * * * * * * * * */
-class Secant final : public SolverWithInterval
+template<class Traits, class F = typename Traits::FunType>
+class BasicSecant final : public BasicSolverWithInterval<Traits, F>
 {
 public:
+	using typename BasicSolverWithInterval<Traits, F>::Real;
+
 	// Constructor for when interval extremes are provided by the user
-	Secant(const T::FunType& f_, const T::Real& a_, const T::Real& b_, const T::Real& tol_, const T::Real& tola_, const unsigned int& maxIt_, const T::Real& h_interval_ = 0.01, const unsigned int& maxIter_ = 200) : 
-		SolverWithInterval(f_, a_, b_, tol_, h_interval_, maxIter_), tola(tola_), maxIt(maxIt_) {}
-	
-	T::Real solve() override;
+	BasicSecant(const F& f_, const Real& a_, const Real& b_, const Real& tol_, const Real& tola_, const unsigned int& maxIt_, const Real& h_interval_ = 0.01, const unsigned int& maxIter_ = 200, const BracketStrategy& strategy_ = BracketStrategy::Linear) :
+		BasicSolverWithInterval<Traits, F>(f_, a_, b_, tol_, h_interval_, maxIter_, strategy_), tola(tola_), maxIt(maxIt_) {}
+
+	Real solve() override;
+	using BasicSolverWithInterval<Traits, F>::solve;
+
+	// Changes all the parameters and the interval
+	void reset(const typename BasicSolverWithInterval<Traits, F>::Parameters& p) override
+	{
+		tola = p.tola;
+		maxIt = p.maxIt;
+		BasicSolverWithInterval<Traits, F>::reset(p);
+	}
 
 protected:
+	using BasicSolverWithInterval<Traits, F>::f;
+	using BasicSolverWithInterval<Traits, F>::tol;
+	using BasicSolverWithInterval<Traits, F>::a;
+	using BasicSolverWithInterval<Traits, F>::b;
+	using BasicSolverWithInterval<Traits, F>::fa;
+	using BasicSolverWithInterval<Traits, F>::fb;
+
 	// Absolute tolerance
-	T::Real tola;
+	Real tola;
 	// Maximum number of iterations
-	unsigned int maxIt; 	
+	unsigned int maxIt;
 };
 
 /* * * * * * * * *
  * Brent method  *
  * * * * * * * * */
-class Brent final : public SolverWithInterval
+template<class Traits, class F = typename Traits::FunType>
+class BasicBrent final : public BasicSolverWithInterval<Traits, F>
 {
 public:
+	using typename BasicSolverWithInterval<Traits, F>::Real;
+
 	// Constructor for when interval extremes are provided by the user
-	Brent(const T::FunType& f_, const T::Real& a_, const T::Real& b_, const T::Real tol_, const unsigned int& maxIt_, const T::Real& h_interval_ = 0.01, const unsigned int& maxIter_ = 200) : 
-		SolverWithInterval(f_, a_, b_, tol_, h_interval_, maxIter_), maxIt(maxIt_) {}
+	BasicBrent(const F& f_, const Real& a_, const Real& b_, const Real tol_, const unsigned int& maxIt_, const Real& h_interval_ = 0.01, const unsigned int& maxIter_ = 200, const BracketStrategy& strategy_ = BracketStrategy::Linear) :
+		BasicSolverWithInterval<Traits, F>(f_, a_, b_, tol_, h_interval_, maxIter_, strategy_), maxIt(maxIt_) {}
+
+	Real solve() override;
+	using BasicSolverWithInterval<Traits, F>::solve;
+
+	// Changes all the parameters and the interval
+	void reset(const typename BasicSolverWithInterval<Traits, F>::Parameters& p) override
+	{
+		maxIt = p.maxIt;
+		BasicSolverWithInterval<Traits, F>::reset(p);
+	}
+
+protected:
+	using BasicSolverWithInterval<Traits, F>::f;
+	using BasicSolverWithInterval<Traits, F>::tol;
+	using BasicSolverWithInterval<Traits, F>::a;
+	using BasicSolverWithInterval<Traits, F>::b;
+	using BasicSolverWithInterval<Traits, F>::fa;
+	using BasicSolverWithInterval<Traits, F>::fb;
+
+	// Maximum number of iterations
+	unsigned int maxIt;
+};
+
+/* * * * * * * * * * * * * * * * * * * * *
+ * Newton method safeguarded by bisection *
+ * * * * * * * * * * * * * * * * * * * * */
+/*!
+ * Keeps a bracket of the zero, as bisection, and takes the Newton step
+ * from the last point when it falls inside the bracket and halves the
+ * step before the last one; otherwise it bisects. It converges as
+ * bisection in the worst case and quadratically near a simple zero.
+ * f and df are evaluated once per iteration
+ */
+template<class Traits, class F = typename Traits::FunType, class DF = F>
+class BasicSafeNewton final : public BasicSolverWithInterval<Traits, F>
+{
+public:
+	using typename BasicSolverWithInterval<Traits, F>::Real;
+
+	// Constructor for when the interval is provided by the user
+	BasicSafeNewton(const F& f_, const DF& df_, const Real& a_, const Real& b_, const Real& tol_, const Real& tola_, const unsigned int& maxIt_, const Real& h_interval_ = 0.01, const unsigned int& maxIter_ = 200, const BracketStrategy& strategy_ = BracketStrategy::Linear) :
+		BasicSolverWithInterval<Traits, F>(f_, a_, b_, tol_, h_interval_, maxIter_, strategy_), df(df_), tola(tola_), maxIt(maxIt_) {}
+
+	Real solve() override;
+	using BasicSolverWithInterval<Traits, F>::solve;
+
+	// Changes the derivative
+	void setDerivative(const DF& df_) {df = df_;}
+
+	// Changes all the parameters and the interval
+	void reset(const typename BasicSolverWithInterval<Traits, F>::Parameters& p) override
+	{
+		tola = p.tola;
+		maxIt = p.maxIt;
+		BasicSolverWithInterval<Traits, F>::reset(p);
+	}
+
+protected:
+	using BasicSolverWithInterval<Traits, F>::f;
+	using BasicSolverWithInterval<Traits, F>::tol;
+	using BasicSolverWithInterval<Traits, F>::a;
+	using BasicSolverWithInterval<Traits, F>::b;
+	using BasicSolverWithInterval<Traits, F>::fa;
+	using BasicSolverWithInterval<Traits, F>::fb;
+
+	// Derivative of the function
+	DF df;
+	// Absolute tolerance on the residual
+	Real tola;
+	// Maximum number of iterations
+	unsigned int maxIt;
+
+	// Evaluates df, counting the call
+	Real evalDF(const Real& x)
+	{
+		++this->stats.dfEvals;
+		return df(x);
+	}
+};
+
+// Scaling of the retained extreme in the modified regula falsi
+enum class SideScaling
+{
+	Illinois,      // halve its value
+	AndersonBjorck // multiply its value by 1 - f(c)/f(b), or by 1/2 if not positive
+};
 
-	T::Real solve() override;
+/* * * * * * * * * * * * * * * * * *
+ * Modified Regula Falsi method    *
+ * * * * * * * * * * * * * * * * * */
+/*!
+ * The regula falsi keeps one extreme fixed when f is convex or concave
+ * in the interval, and converges linearly. When the same extreme is kept
+ * twice in a row its value of f is scaled in the chord, which restores the
+ * superlinear convergence
+ */
+template<class Traits, class F = typename Traits::FunType>
+class BasicModifiedRegulaFalsi final : public BasicSolverWithInterval<Traits, F>
+{
+public:
+	using typename BasicSolverWithInterval<Traits, F>::Real;
+
+	// Constructor for when the interval is provided by the user
+	BasicModifiedRegulaFalsi(const F& f_, const Real& a_, const Real& b_, const Real& tol_, const Real& tola_, const unsigned int& maxIt_, const SideScaling& scaling_ = SideScaling::Illinois, const Real& h_interval_ = 0.01, const unsigned int& maxIter_ = 200, const BracketStrategy& strategy_ = BracketStrategy::Linear) :
+		BasicSolverWithInterval<Traits, F>(f_, a_, b_, tol_, h_interval_, maxIter_, strategy_), tola(tola_), maxIt(maxIt_), scaling(scaling_) {}
+
+	Real solve() override;
+	using BasicSolverWithInterval<Traits, F>::solve;
+
+	// Changes all the parameters and the interval
+	void reset(const typename BasicSolverWithInterval<Traits, F>::Parameters& p) override
+	{
+		tola = p.tola;
+		maxIt = p.maxIt;
+		BasicSolverWithInterval<Traits, F>::reset(p);
+	}
 
 protected:
+	using BasicSolverWithInterval<Traits, F>::f;
+	using BasicSolverWithInterval<Traits, F>::tol;
+	using BasicSolverWithInterval<Traits, F>::a;
+	using BasicSolverWithInterval<Traits, F>::b;
+	using BasicSolverWithInterval<Traits, F>::fa;
+	using BasicSolverWithInterval<Traits, F>::fb;
+
+	// Absolute tolerance
+	Real tola;
 	// Maximum number of iterations
 	unsigned int maxIt;
+	// Scaling of the retained extreme
+	SideScaling scaling;
 };
 
 /* * * * * * * * *
  * Newton method *
  * * * * * * * * */
-class Newton : public SolverBase{
+template<class Traits, class F = typename Traits::FunType, class DF = F>
+class BasicNewton : public BasicSolverBase<Traits, F>{
 public:
+	using typename BasicSolverBase<Traits, F>::Real;
+
 	// Constructor
-	Newton(const T::FunType& f_, const T::FunType& df_, const T::Real& x0_, const T::Real& tol_, const T::Real& tola_, const unsigned int& maxIt_) : 
-		SolverBase(f_, tol_), df(df_), x0(x0_), tola(tola_), maxIt(maxIt_) {}
+	BasicNewton(const F& f_, const DF& df_, const Real& x0_, const Real& tol_, const Real& tola_, const unsigned int& maxIt_) :
+		BasicSolverBase<Traits, F>(f_, tol_), df(df_), x0(x0_), tola(tola_), maxIt(maxIt_) {}
+
+	Real solve() override;
+	using BasicSolverBase<Traits, F>::solve;
+
+	// Changes all the parameters and the starting point
+	void reset(const typename BasicSolverBase<Traits, F>::Parameters& p) override
+	{
+		x0 = p.x0;
+		tola = p.tola;
+		maxIt = p.maxIt;
+		BasicSolverBase<Traits, F>::reset(p);
+	}
 
-	T::Real solve() override;
+	// Changes the starting point
+	void setProblem(const typename BasicSolverBase<Traits, F>::Problem& problem) override {x0 = problem.x0;}
+
+	// Changes the starting point
+	void setStart(const Real& x0_) {x0 = x0_;}
+
+	// Changes the derivative
+	void setDerivative(const DF& df_) {df = df_;}
 
 protected:
+	using BasicSolverBase<Traits, F>::f;
+	using BasicSolverBase<Traits, F>::tol;
+
 	// Derivative of the function
-	T::FunType df;
+	DF df;
+	// Initial point
+	Real x0;
+	// Absolute tolerance
+	Real tola;
+	// Maximum number of iterations
+	unsigned int maxIt;
+
+	// Evaluates df, counting the call
+	Real evalDF(const Real& x)
+	{
+		++this->stats.dfEvals;
+		return df(x);
+	}
+};
+
+/* * * * * * * * *
+ * Halley method *
+ * * * * * * * * */
+/*!
+ * Cubic convergence using also the second derivative: two derivatives per
+ * iteration, both counted in dfEvals
+ */
+template<class Traits, class F = typename Traits::FunType, class DF = F, class D2F = F>
+class BasicHalley final : public BasicNewton<Traits, F, DF>
+{
+public:
+	using typename BasicNewton<Traits, F, DF>::Real;
+
+	// Constructor
+	BasicHalley(const F& f_, const DF& df_, const D2F& d2f_, const Real& x0_, const Real& tol_, const Real& tola_, const unsigned int& maxIt_) :
+		BasicNewton<Traits, F, DF>(f_, df_, x0_, tol_, tola_, maxIt_), d2f(d2f_) {}
+
+	Real solve() override;
+	using BasicNewton<Traits, F, DF>::solve;
+
+protected:
+	using BasicNewton<Traits, F, DF>::tol;
+	using BasicNewton<Traits, F, DF>::x0;
+	using BasicNewton<Traits, F, DF>::tola;
+	using BasicNewton<Traits, F, DF>::maxIt;
+
+	// Second derivative of the function
+	D2F d2f;
+
+	// Evaluates d2f, counting the call
+	Real evalD2F(const Real& x)
+	{
+		++this->stats.dfEvals;
+		return d2f(x);
+	}
+};
+
+/* * * * * * * * * * * *
+ * Steffensen method   *
+ * * * * * * * * * * * */
+/*!
+ * Quadratic convergence without derivatives: the slope is the divided
+ * difference (f(x + f(x)) - f(x)) / f(x), two evaluations per iteration.
+ * It needs |f| small with respect to the scale of x near the zero
+ */
+template<class Traits, class F = typename Traits::FunType>
+class BasicSteffensen final : public BasicSolverBase<Traits, F>
+{
+public:
+	using typename BasicSolverBase<Traits, F>::Real;
+
+	// Constructor
+	BasicSteffensen(const F& f_, const Real& x0_, const Real& tol_, const Real& tola_, const unsigned int& maxIt_) :
+		BasicSolverBase<Traits, F>(f_, tol_), x0(x0_), tola(tola_), maxIt(maxIt_) {}
+
+	Real solve() override;
+	using BasicSolverBase<Traits, F>::solve;
+
+	// Changes the starting point
+	void setStart(const Real& x0_) {x0 = x0_;}
+
+	// Changes all the parameters and the starting point
+	void reset(const typename BasicSolverBase<Traits, F>::Parameters& p) override
+	{
+		x0 = p.x0;
+		tola = p.tola;
+		maxIt = p.maxIt;
+		BasicSolverBase<Traits, F>::reset(p);
+	}
+
+	// Changes the starting point
+	void setProblem(const typename BasicSolverBase<Traits, F>::Problem& problem) override {x0 = problem.x0;}
+
+protected:
+	using BasicSolverBase<Traits, F>::tol;
+
 	// Initial point
-	T::Real x0;
+	Real x0;
 	// Absolute tolerance
-	T::Real tola;
+	Real tola;
 	// Maximum number of iterations
 	unsigned int maxIt;
 };
 
+// Central difference approximation of the derivative of f, the derivative of the Newton base of QuasiNewton
+// (QuasiNewton::solve evaluates the difference itself, to count its evaluations of f)
+template<class Traits, class F>
+struct CentralDifference
+{
+	using Real = typename Traits::Real;
+
+	Real operator()(const Real& x) const {return (f(x + h) - f(x - h)) / (2 * h);}
+
+	F f;
+	Real h;
+};
+
 /* * * * * * * * * * * *
  * QuasiNewton method  *
  * * * * * * * * * * * */
-class QuasiNewton final : public Newton
+/*!
+ * Newton with the derivative approximated as chosen by SlopeUpdate. Every
+ * slope evaluates only f, and all the evaluations are counted in fEvals:
+ * with the Central slope an iteration costs three of them
+ */
+template<class Traits, class F = typename Traits::FunType>
+class BasicQuasiNewton final : public BasicNewton<Traits, F, CentralDifference<Traits, F>>
 {
 public:
+	using typename BasicNewton<Traits, F, CentralDifference<Traits, F>>::Real;
+
 	// Constructor
-	QuasiNewton(const T::FunType& f_, const T::Real& a_, const T::Real& h_, const T::Real& tol_, const T::Real& tola_, const unsigned int& maxIt_) : 
-		Newton(f_, [f_, h_](const T::Real& x){return (f_(x + h_) - f_(x - h_)) / (2 * h_);}, a_, tol_, tola_, maxIt_), h(h_) {}
+	BasicQuasiNewton(const F& f_, const Real& a_, const Real& h_, const Real& tol_, const Real& tola_, const unsigned int& maxIt_, const SlopeUpdate& slope_ = SlopeUpdate::Central, const unsigned int& refresh_ = 5) :
+		BasicNewton<Traits, F, CentralDifference<Traits, F>>(f_, CentralDifference<Traits, F>{f_, h_}, a_, tol_, tola_, maxIt_), h(h_), slope(slope_), refresh(refresh_ > 0 ? refresh_ : 1) {}
+
+	Real solve() override;
+	using BasicSolverBase<Traits, F>::solve;
+
+	// Changes the approximation of the derivative, refresh is used by the Chord slope
+	void setSlopeUpdate(const SlopeUpdate& slope_, const unsigned int& refresh_ = 5)
+	{
+		slope = slope_;
+		refresh = refresh_ > 0 ? refresh_ : 1;
+	}
+
+	// Changes all the parameters and the starting point
+	void reset(const typename BasicSolverBase<Traits, F>::Parameters& p) override
+	{
+		h = p.h;
+		this->df.h = p.h;
+		setSlopeUpdate(p.slope, p.refresh);
+		BasicNewton<Traits, F, CentralDifference<Traits, F>>::reset(p);
+	}
 
 protected:
+	using BasicNewton<Traits, F, CentralDifference<Traits, F>>::x0;
+	using BasicNewton<Traits, F, CentralDifference<Traits, F>>::tol;
+	using BasicNewton<Traits, F, CentralDifference<Traits, F>>::tola;
+	using BasicNewton<Traits, F, CentralDifference<Traits, F>>::maxIt;
+
 	// Step for computing the derivative
-	T::Real h;
+	Real h;
+	// Approximation of the derivative
+	SlopeUpdate slope;
+	// Iterations between two differences of the Chord slope
+	unsigned int refresh;
+
+	// The approximation of the derivative uses the new function
+	void functionChanged() override
+	{
+		if constexpr (std::is_copy_assignable_v<F>)
+			this->df.f = this->f;
+	}
+};
+
+// Value of a function on dual numbers, the function of AutoDiffNewton for the base class
+template<class Traits, class G>
+struct DualValue
+{
+	using Real = typename Traits::Real;
+
+	Real operator()(const Real& x) const {return g(Dual<Real>(x)).v;}
+
+	G g;
+};
+
+// Derivative of a function on dual numbers, for the solvers that take df
+// (it evaluates also the value, so it costs as one evaluation of G)
+template<class Traits, class G>
+struct DualDerivative
+{
+	using Real = typename Traits::Real;
+
+	Real operator()(const Real& x) const {return g(Dual<Real>(x, Real(1))).d;}
+
+	G g;
+};
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Newton method with automatic differentiation    *
+ * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*!
+ * The function g is evaluated on dual numbers (Dual.hpp), which gives f and
+ * its exact derivative in one pass: one evaluation per iteration, against
+ * f and df for Newton and three evaluations of f for QuasiNewton. G is a
+ * callable on Dual<Real>, e.g. a generic lambda; every evaluation counts
+ * both in fEvals and in dfEvals. The base class holds the values of g only,
+ * as F (a std::function for the type-erased AutoDiffNewton).
+ */
+template<class Traits, class G = typename Traits::DualFunType, class F = typename Traits::FunType>
+class BasicAutoDiffNewton final : public BasicSolverBase<Traits, F>
+{
+public:
+	using typename BasicSolverBase<Traits, F>::Real;
+
+	// Constructor
+	BasicAutoDiffNewton(const G& g_, const Real& x0_, const Real& tol_, const Real& tola_, const unsigned int& maxIt_) :
+		BasicSolverBase<Traits, F>(DualValue<Traits, G>{g_}, tol_), g(g_), x0(x0_), tola(tola_), maxIt(maxIt_) {}
+
+	Real solve() override;
+	using BasicSolverBase<Traits, F>::solve;
+
+	// Changes the function on dual numbers
+	void setFunction(const G& g_)
+	{
+		g = g_;
+		this->f = DualValue<Traits, G>{g_};
+	}
+
+	// Changes the starting point
+	void setStart(const Real& x0_) {x0 = x0_;}
+
+	// Changes all the parameters and the starting point
+	void reset(const typename BasicSolverBase<Traits, F>::Parameters& p) override
+	{
+		x0 = p.x0;
+		tola = p.tola;
+		maxIt = p.maxIt;
+		BasicSolverBase<Traits, F>::reset(p);
+	}
+
+	// Changes the starting point
+	void setProblem(const typename BasicSolverBase<Traits, F>::Problem& problem) override {x0 = problem.x0;}
+
+protected:
+	using BasicSolverBase<Traits, F>::tol;
+
+	// Function on dual numbers
+	G g;
+	// Initial point
+	Real x0;
+	// Absolute tolerance
+	Real tola;
+	// Maximum number of iterations
+	unsigned int maxIt;
+
+	// A function without derivative cannot be used
+	void functionChanged() override
+	{
+		Logger::log(LogLevel::Warning, "AutoDiffNewton needs a function on dual numbers, the new function is not used");
+	}
+
+	// Evaluates f and df at x, counting the call
+	Dual<Real> evalFDF(const Real& x)
+	{
+		++this->stats.fEvals;
+		++this->stats.dfEvals;
+		return g(Dual<Real>(x, Real(1)));
+	}
 };
 
+// Deduce F (and DF) from the arguments, the traits default to SolverTraits
+template<class F, class ... Args>
+BasicRegulaFalsi(const F&, const Args&...) -> BasicRegulaFalsi<SolverTraits, F>;
+template<class F, class ... Args>
+BasicBisection(const F&, const Args&...) -> BasicBisection<SolverTraits, F>;
+template<class F, class ... Args>
+BasicMultisection(const F&, const Args&...) -> BasicMultisection<SolverTraits, F>;
+template<class F, class ... Args>
+BasicSecant(const F&, const Args&...) -> BasicSecant<SolverTraits, F>;
+template<class F, class ... Args>
+BasicBrent(const F&, const Args&...) -> BasicBrent<SolverTraits, F>;
+template<class F, class DF, class ... Args>
+BasicSafeNewton(const F&, const DF&, const SolverTraits::Real&, const Args&...) -> BasicSafeNewton<SolverTraits, F, DF>;
+template<class F, class ... Args>
+BasicModifiedRegulaFalsi(const F&, const Args&...) -> BasicModifiedRegulaFalsi<SolverTraits, F>;
+template<class F, class DF, class ... Args>
+BasicNewton(const F&, const DF&, const SolverTraits::Real&, const Args&...) -> BasicNewton<SolverTraits, F, DF>;
+template<class F, class DF, class D2F, class ... Args>
+BasicHalley(const F&, const DF&, const D2F&, const SolverTraits::Real&, const Args&...) -> BasicHalley<SolverTraits, F, DF, D2F>;
+template<class F, class ... Args>
+BasicSteffensen(const F&, const Args&...) -> BasicSteffensen<SolverTraits, F>;
+template<class F, class ... Args>
+BasicQuasiNewton(const F&, const Args&...) -> BasicQuasiNewton<SolverTraits, F>;
+template<class G, class ... Args>
+BasicAutoDiffNewton(const G&, const Args&...) -> BasicAutoDiffNewton<SolverTraits, G, DualValue<SolverTraits, G>>;
+
+// Type-erased solvers
+using SolverBase = BasicSolverBase<SolverTraits>;
+using SolverWithInterval = BasicSolverWithInterval<SolverTraits>;
+using RegulaFalsi = BasicRegulaFalsi<SolverTraits>;
+using Bisection = BasicBisection<SolverTraits>;
+using Multisection = BasicMultisection<SolverTraits>;
+using Secant = BasicSecant<SolverTraits>;
+using Brent = BasicBrent<SolverTraits>;
+using SafeNewton = BasicSafeNewton<SolverTraits>;
+using ModifiedRegulaFalsi = BasicModifiedRegulaFalsi<SolverTraits>;
+using Newton = BasicNewton<SolverTraits>;
+using Halley = BasicHalley<SolverTraits>;
+using Steffensen = BasicSteffensen<SolverTraits>;
+using QuasiNewton = BasicQuasiNewton<SolverTraits>;
+using AutoDiffNewton = BasicAutoDiffNewton<SolverTraits>;
+
+// The type-erased solvers are instantiated in libclassZeroFun.so
+extern template class BasicSolverWithInterval<SolverTraits>;
+extern template class BasicRegulaFalsi<SolverTraits>;
+extern template class BasicBisection<SolverTraits>;
+extern template class BasicMultisection<SolverTraits>;
+extern template class BasicSecant<SolverTraits>;
+extern template class BasicBrent<SolverTraits>;
+extern template class BasicSafeNewton<SolverTraits>;
+extern template class BasicModifiedRegulaFalsi<SolverTraits>;
+extern template class BasicNewton<SolverTraits>;
+extern template class BasicHalley<SolverTraits>;
+extern template class BasicSteffensen<SolverTraits>;
+extern template class BasicNewton<SolverTraits, SolverTraits::FunType, CentralDifference<SolverTraits, SolverTraits::FunType>>;
+extern template class BasicQuasiNewton<SolverTraits>;
+extern template class BasicAutoDiffNewton<SolverTraits>;
+
+#include "classZeroFun_impl.hpp"
+
 #endif
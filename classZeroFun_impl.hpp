@@ -0,0 +1,1133 @@
+#ifndef _CLASS_ZERO_FUN_IMPL_HPP_
+#define _CLASS_ZERO_FUN_IMPL_HPP_
+
+// Implementation of the solvers declared in classZeroFun.hpp
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+// Solve with statistics
+/*!
+ * Solves measuring the wall time and returns the statistics of the solve.
+ * The counters are reset afterwards, so that a new call reports only its own
+ * evaluations.
+ *
+ * @return the zero and the statistics of the solve
+ */
+template<class Traits, class F>
+BasicSolveStats<Traits> BasicSolverBase<Traits, F>::solveWithStats()
+{
+	collect = true;
+	const auto start = std::chrono::steady_clock::now();
+	stats.zero = solve();
+	stats.wallTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	collect = false;
+
+	BasicSolveStats<Traits> result = std::move(stats);
+	stats = BasicSolveStats<Traits>();
+	return result;
+}
+
+// Check of the stopping policy
+/*!
+ * @return true if the solve must stop, with the outcome in policyStatus
+ */
+template<class Traits, class F>
+bool BasicSolverBase<Traits, F>::checkPolicy(const Real& x, const Real& dx, const Real& fx)
+{
+	if (policy.converged(x, dx, fx))
+		policyStatus = SolveStatus::Converged;
+	else if (policy.maxEvals > 0 && stats.fEvals + stats.dfEvals - policyEvals >= policy.maxEvals)
+		policyStatus = SolveStatus::BudgetExhausted;
+	else if (policy.deadline > 0 && std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - policyStart).count() >= policy.deadline)
+		policyStatus = SolveStatus::DeadlineExceeded;
+	else
+		return false;
+	return true;
+}
+
+// Constructor of the solvers with interval
+/*!
+ * If f does not change sign at the extremes, a valid interval is searched
+ * with bracketInterval starting from the midpoint
+ */
+template<class Traits, class F>
+BasicSolverWithInterval<Traits, F>::BasicSolverWithInterval(const F& f_, const Real& a_, const Real& b_, const Real& tol_, const Real& h_interval_, const unsigned int& maxIter_, const BracketStrategy& strategy_) :
+	BasicSolverBase<Traits, F>(f_, tol_), h_interval(h_interval_), maxIter(maxIter_), strategy(strategy_)
+{
+	setInterval(a_, b_);
+}
+
+// Set a new interval
+/*!
+ * Evaluates f at the extremes and, if it does not change sign, searches a
+ * valid interval with bracketInterval starting from the midpoint. If none
+ * is found the interval is set to [-NaN, NaN]
+ */
+template<class Traits, class F>
+void BasicSolverWithInterval<Traits, F>::setInterval(const Real& a_, const Real& b_)
+{
+	a = a_;
+	b = b_;
+	x1 = (a_ + b_) / 2.;
+	fa = evalF(a);
+	fb = evalF(b);
+	if (fa * fb > 0)
+	{
+		// If the interval is not valid, look for a valid one
+		Logger::log(LogLevel::Warning, "The provided interval is not valid... Trying to find a valid one");
+
+		auto result = bracketInterval(x1, h_interval, maxIter);
+		if (std::get<2>(result))
+		{
+			// If valid interval was found initialize extremes
+			a = std::get<0>(result);
+			b = std::get<1>(result);
+			fa = evalF(a);
+			fb = evalF(b);
+		}
+		else 
+		{
+			Logger::log(LogLevel::Error, "Could not find an interval, the function has no zero. Interval will be set to [-Nan, Nan]");
+			a = -std::numeric_limits<Real>::quiet_NaN();
+			b = std::numeric_limits<Real>::quiet_NaN();
+			fa = std::numeric_limits<Real>::quiet_NaN();
+			fb = std::numeric_limits<Real>::quiet_NaN();
+		}
+	}
+}
+
+// Reset of the solvers with interval
+/*!
+ * Changes the parameters of the search of a valid interval, then sets the
+ * new interval as the constructor does
+ */
+template<class Traits, class F>
+void BasicSolverWithInterval<Traits, F>::reset(const typename BasicSolverBase<Traits, F>::Parameters& p)
+{
+	BasicSolverBase<Traits, F>::reset(p);
+	h_interval = p.h_interval;
+	maxIter = p.maxIter;
+	strategy = p.strategy;
+	setInterval(p.a, p.b);
+}
+
+// Bracket interval function implemetation
+/*!
+ * This function tries to find an interval that brackets the zero of a
+ * function f. It does so by sampling the value of f at points
+ * generated starting from a given point, with the strategy chosen at
+ * construction
+ *
+ * @param x1 initial point
+ * @param h initial increment for the sampling
+ * @param maxIter maximum number of iterations
+ * @return a tuple with the bracketing points and a bool which is true if number
+ * of iterations not exceeded (bracket found)
+ */
+template<class Traits, class F>
+auto BasicSolverWithInterval<Traits, F>::bracketInterval(Real x1, Real h, unsigned int maxIter) -> std::tuple<Real, Real, bool>
+{
+	std::tuple<Real, Real, bool> result;
+	switch (strategy)
+	{
+		case BracketStrategy::Golden:
+			result = bracketGolden(x1, h, maxIter);
+			break;
+		case BracketStrategy::Extrapolation:
+			result = bracketExtrapolation(x1, h, maxIter);
+			break;
+		default:
+			result = bracketLinear(x1, h, maxIter);
+	}
+	if (std::get<2>(result))
+		Logger::log(LogLevel::Info, "Bracket interval found: [", std::get<0>(result), ", ", std::get<1>(result), "]");
+
+	return result;
+}
+
+// Linear search
+/*!
+ * Walks from x1 in the direction where |f| decreases, with a step that is
+ * multiplied by 1.5 at every iteration
+ */
+template<class Traits, class F>
+auto BasicSolverWithInterval<Traits, F>::bracketLinear(Real x1, Real h, unsigned int maxIter) -> std::tuple<Real, Real, bool>
+{
+	constexpr Real expandFactor = 1.5;
+	auto direction = 1.0;
+	auto	x2 = x1 + h;
+	auto y1 = evalF(x1);
+	auto y2 = evalF(x2); 
+	unsigned int iter{0u};
+
+	// Get initial decrement direction
+	while ((y1 * y2 > 0) && (iter < maxIter))
+	{
+		++iter;
+		if (std::abs(y2) > std::abs(y1))
+		{
+			std::swap(y1, y2);
+			std::swap(x1, x2);
+		}
+
+		direction = (x2 > x1) ? 1.0 : -1.0;
+		x1 = x2;
+		y1 = y2;
+		x2 += direction * h;
+		y2 = evalF(x2);
+		h *= expandFactor;
+	}
+	// swap to get elements in the correct order even when negative
+	if (x1 > x2)
+		std::swap(x1, x2);
+
+	return std::make_tuple(x1, x2, iter < maxIter);
+}
+
+// Golden-section expansion
+/*!
+ * Keeps both extremes of [x1, x1 + h] and moves outward the one where |f|
+ * is smaller, by the golden ratio times the width of the interval. The
+ * width grows geometrically, so a zero at distance d is bracketed in
+ * O(log(d / h)) evaluations
+ */
+template<class Traits, class F>
+auto BasicSolverWithInterval<Traits, F>::bracketGolden(Real x1, Real h, unsigned int maxIter) -> std::tuple<Real, Real, bool>
+{
+	constexpr Real golden = 1.618033988749895;
+	auto x2 = x1 + h;
+	auto y1 = evalF(x1);
+	auto y2 = evalF(x2);
+	unsigned int iter{0u};
+
+	while ((y1 * y2 > 0) && (iter < maxIter))
+	{
+		++iter;
+		if (std::abs(y1) < std::abs(y2))
+		{
+			x1 += golden * (x1 - x2);
+			y1 = evalF(x1);
+		}
+		else
+		{
+			x2 += golden * (x2 - x1);
+			y2 = evalF(x2);
+		}
+	}
+
+	return std::make_tuple(x1, x2, iter < maxIter);
+}
+
+// Search by extrapolation
+/*!
+ * Walks like the linear search, but the next point is predicted from the
+ * previous samples: with three samples it is the zero of the interpolating
+ * quadratic in the walking direction, otherwise (or if the quadratic has no
+ * such zero) the zero of the secant. The prediction is pushed 20% further, so
+ * that the zero is likely to be crossed, and the step is kept between the
+ * previous step times 1.5 (the growth of the linear search) and 8 times it,
+ * so that the search is never slower than the linear one and does not jump
+ * too far on a wrong prediction
+ */
+template<class Traits, class F>
+auto BasicSolverWithInterval<Traits, F>::bracketExtrapolation(Real x1, Real h, unsigned int maxIter) -> std::tuple<Real, Real, bool>
+{
+	constexpr Real overshoot = 1.2;
+	constexpr Real minGrowth = 1.5;
+	constexpr Real maxGrowth = 8.;
+	auto x2 = x1 + h;
+	auto y1 = evalF(x1);
+	auto y2 = evalF(x2);
+	// Sample before x1, used for the quadratic
+	Real x0{x1};
+	Real y0{y1};
+	bool haveThree{false};
+	unsigned int iter{0u};
+
+	while ((y1 * y2 > 0) && (iter < maxIter))
+	{
+		++iter;
+		if (std::abs(y2) > std::abs(y1))
+		{
+			// Turn back, the older sample is on the wrong side
+			std::swap(y1, y2);
+			std::swap(x1, x2);
+			haveThree = false;
+		}
+
+		const Real step = x2 - x1;
+		// Secant prediction
+		Real t = (y2 != y1) ? -y2 * step / (y2 - y1) : maxGrowth * step;
+		if (haveThree)
+		{
+			// Newton form of the quadratic through the three samples, in t = x - x2
+			const Real d1 = (y2 - y1) / (x2 - x1);
+			const Real d2 = (d1 - (y1 - y0) / (x1 - x0)) / (x2 - x0);
+			const Real qa = d2;
+			const Real qb = d1 + d2 * (x2 - x1);
+			const Real disc = qb * qb - 4 * qa * y2;
+			if (qa != 0. && disc >= 0.)
+			{
+				// Stable formula, take the zero in the walking direction closest to x2
+				const Real q = -0.5 * (qb + std::copysign(std::sqrt(disc), qb));
+				Real t1 = q / qa;
+				Real t2 = (q != 0.) ? y2 / q : t1;
+				if (t1 * step <= 0. || (t2 * step > 0. && std::abs(t2) < std::abs(t1)))
+					std::swap(t1, t2);
+				if (t1 * step > 0.)
+					t = t1;
+			}
+		}
+		t *= overshoot;
+		// Safeguard on the length and the direction of the step
+		if (!std::isfinite(t) || t * step <= 0. || std::abs(t) < minGrowth * std::abs(step))
+			t = std::copysign(minGrowth * std::abs(step), step);
+		else if (std::abs(t) > maxGrowth * std::abs(step))
+			t = std::copysign(maxGrowth * std::abs(step), step);
+
+		x0 = x1;
+		y0 = y1;
+		x1 = x2;
+		y1 = y2;
+		x2 += t;
+		y2 = evalF(x2);
+		haveThree = true;
+	}
+	if (x1 > x2)
+		std::swap(x1, x2);
+
+	return std::make_tuple(x1, x2, iter < maxIter);
+}
+
+// Regula Falsi 
+/*!
+ * Compute the zero of a scalar function with the method of regula falsi
+ *
+ * @return The approximation of the zero of f (NaN if not found) 
+ */
+template<class Traits, class F>
+auto BasicRegulaFalsi<Traits, F>::solve() -> Real
+{
+	this->beginSolve();
+	// Working bracket, the members stay the interval of the problem
+	Real a{this->a};
+	Real b{this->b};
+	Real ya = fa;
+	Real yb = fb;
+	Real delta = b - a;
+	Real resid0 = std::max(std::abs(ya), std::abs(yb));
+  if (!(ya * yb <= 0))
+	{
+		Logger::log(LogLevel::Error, "ERROR, function must change sign at the two end values");
+		this->setStats(SolveStatus::InvalidInterval, 0u, std::min(std::abs(ya), std::abs(yb)), b - a);
+
+		return std::numeric_limits<Real>::quiet_NaN();
+	}
+
+	Real yc{ya};
+	Real c{a};
+	unsigned int iter{0u};
+	bool stopped{false};
+	Real incr = std::numeric_limits<Real>::max();
+  constexpr Real small = 10.0 * std::numeric_limits<Real>::epsilon();
+  while(std::abs(yc) > tol * resid0 + tola && incr > small)
+    {
+			++iter;
+			Real incra = -ya / (yb - ya);
+			Real incrb = 1. - incra;
+			Real incr = std::min(incra, incrb);
+      if (!(std::max(incra, incrb) <= 1.0 && incr >= 0))
+					{
+						Logger::log(LogLevel::Error, "Chord is failing");
+						this->setStats(SolveStatus::ChordFailed, iter, std::abs(yc), b - a);
+
+						return std::numeric_limits<Real>::quiet_NaN();
+					}
+			
+      const Real cOld = c;
+      c = a + incra * delta;
+      yc = this->evalF(c);
+      if(yc * ya < 0.0)
+        {
+          yb = yc;
+          b = c;
+        }
+      else
+        {
+          ya = yc;
+          a = c;
+        }
+      delta = b - a;
+      this->trace("RegulaFalsi", TraceStep::Chord, iter, c, yc, a, b);
+      if (this->usePolicy && std::abs(yc) > tol * resid0 + tola && this->checkPolicy(c, c - cOld, yc))
+        {
+          stopped = true;
+          break;
+        }
+    }
+  this->setStats(stopped ? this->policyStatus : SolveStatus::Converged, iter, std::abs(yc), b - a);
+  return c;
+}
+
+// Bisection implemetation
+/*!
+ * Compute the zero of a scalar function with the method of bisection
+ * The returned value is far from the zero at most given tolerance;
+ *
+ * @return The approximation of the zero of f (NaN if not found)
+ *
+ */
+template<class Traits, class F>
+auto BasicBisection<Traits, F>::solve() -> Real
+{
+	this->beginSolve();
+	// Working bracket, the members stay the interval of the problem
+	Real a{this->a};
+	Real b{this->b};
+	Real ya = fa;
+	Real yb = fb;
+	Real delta = b - a;
+
+	if (!(ya * yb <= 0))
+	{
+		Logger::log(LogLevel::Error, "ERROR, function must change sign at the two end values");
+		this->setStats(SolveStatus::InvalidInterval, 0u, std::min(std::abs(ya), std::abs(yb)), b - a);
+
+		return std::numeric_limits<Real>::quiet_NaN();
+	}
+
+	Real yc{ya};
+	Real c{a}; 
+	unsigned int iter{0u};
+	bool stopped{false};
+	while (std::abs(delta) > 2 * tol)
+	{
+		++iter;
+		c = (a + b) / 2.;
+		yc = this->evalF(c); 
+		
+		if (yc * ya < 0.0)
+		{
+			ZEROFUN_KEEP_BRANCH();
+			yb = yc; 
+			b = c;
+		}
+		else
+		{
+			ya = yc;
+			a = c;
+		}
+		delta = b - a;
+		this->trace("Bisection", TraceStep::Bisection, iter, c, yc, a, b);
+		if (this->usePolicy && std::abs(delta) > 2 * tol && this->checkPolicy((a + b) / 2., delta, yc))
+		{
+			stopped = true;
+			break;
+		}
+	}
+	this->setStats(stopped ? this->policyStatus : SolveStatus::Converged, iter, std::abs(yc), b - a);
+	return (a + b) / 2.;
+}
+
+// Multisection method implementation
+/*!
+ * The k - 1 points are evaluated as a block and counted together, the
+ * first part where f changes sign is kept. A point where f is exactly 0
+ * ends the solve
+ *
+ * @return The approximation of the zero (NaN if f does not change sign)
+ */
+template<class Traits, class F>
+auto BasicMultisection<Traits, F>::solve() -> Real
+{
+	this->beginSolve();
+	// Working bracket, the members stay the interval of the problem
+	Real a{this->a};
+	Real b{this->b};
+	Real ya = fa;
+	Real yb = fb;
+
+	if (!(ya * yb <= 0))
+	{
+		Logger::log(LogLevel::Error, "ERROR, function must change sign at the two end values");
+		this->setStats(SolveStatus::InvalidInterval, 0u, std::min(std::abs(ya), std::abs(yb)), b - a);
+
+		return std::numeric_limits<Real>::quiet_NaN();
+	}
+	if (ya == 0. || yb == 0.)
+	{
+		this->setStats(SolveStatus::Converged, 0u, 0., b - a);
+		return (ya == 0.) ? a : b;
+	}
+
+	const std::size_t m = sections - 1;
+	xs.resize(m);
+	ys.resize(m);
+	const bool parallel = pool && pool->size() > 1;
+	const std::size_t grain = parallel ? (m + pool->size() - 1) / pool->size() : m;
+	Real yc{ya};
+	unsigned int iter{0u};
+	bool stopped{false};
+	while (b - a > 2 * tol)
+	{
+		++iter;
+		const Real h = (b - a) / sections;
+		for (std::size_t i = 0; i < m; ++i)
+			xs[i] = a + (i + 1) * h;
+		if (parallel)
+			pool->parallelFor(m, [this](std::size_t i) {ys[i] = f(xs[i]);}, grain);
+		else
+			for (std::size_t i = 0; i < m; ++i)
+				ys[i] = f(xs[i]);
+		this->stats.fEvals += m;
+
+		// First part where f changes sign
+		std::size_t i{0};
+		while (i < m && ys[i] * ya > 0)
+			++i;
+		if (i < m && ys[i] == 0.)
+		{
+			a = b = xs[i];
+			ya = yb = yc = 0.;
+			this->trace("Multisection", TraceStep::Multisection, iter, a, yc, a, b);
+			break;
+		}
+		if (i > 0)
+		{
+			a = xs[i - 1];
+			ya = ys[i - 1];
+		}
+		if (i < m)
+		{
+			b = xs[i];
+			yb = ys[i];
+		}
+		yc = (std::abs(ya) < std::abs(yb)) ? ya : yb;
+		this->trace("Multisection", TraceStep::Multisection, iter, (std::abs(ya) < std::abs(yb)) ? a : b, yc, a, b);
+		if (this->usePolicy && b - a > 2 * tol && this->checkPolicy((a + b) / 2., b - a, yc))
+		{
+			stopped = true;
+			break;
+		}
+	}
+	this->setStats(stopped ? this->policyStatus : SolveStatus::Converged, iter, std::abs(yc), b - a);
+	return (a + b) / 2.;
+}
+
+// Secant implemetation
+/*!
+ * Computes the zero of a scalar function with the method of the secant
+ * 
+ * @return The approximation of the zero of f (NaN if not found)
+ *
+ */
+template<class Traits, class F>
+auto BasicSecant<Traits, F>::solve() -> Real
+{
+	this->beginSolve();
+	// b is fixed, only a is updated, in a local: the members stay the interval of the problem
+	Real a{this->a};
+	Real ya = fa;
+	const Real yb = fb;
+	if (std::isnan(ya) || std::isnan(yb))
+	{
+		Logger::log(LogLevel::Error, "ERROR, no valid interval to start from");
+		this->setStats(SolveStatus::InvalidInterval, 0u, std::abs(ya));
+
+		return std::numeric_limits<Real>::quiet_NaN();
+	}
+	Real resid = std::abs(ya); 
+	Real c{a}; 
+	unsigned int iter{0u};
+	Real check = tol * resid + tola;
+	bool goOn = resid > check;
+	bool stopped{false};
+
+	while (goOn && iter < maxIt)
+	{
+		++iter; 
+		c = a - ya * (b - a) / (yb - ya);
+		Real yc = this->evalF(c);
+		resid = std::abs(yc); 
+		goOn = resid > check;
+		const Real dx = c - a;
+		ya = yc; 
+		a = c;
+		this->trace("Secant", TraceStep::Secant, iter, c, yc);
+		if (this->usePolicy && goOn && this->checkPolicy(c, dx, yc))
+		{
+			stopped = true;
+			break;
+		}
+	}
+	const SolveStatus status = stopped ? this->policyStatus : !std::isfinite(c) ? SolveStatus::Diverged : iter < maxIt ? SolveStatus::Converged : SolveStatus::MaxIterations;
+	this->setStats(status, iter, resid);
+
+	if (status == SolveStatus::Converged || stopped)
+		return c; 
+	else 
+	{
+		Logger::log(LogLevel::Error, "ERROR, could not find the zero");
+ 
+		return std::numeric_limits<Real>::quiet_NaN();
+	}
+}
+
+// Brent implemetation
+/*!
+ *	Computes the zero of a scalar function with the brent method
+ *
+ *	@return The approximation of the zero of f (NaN if not found)
+ */
+template<class Traits, class F>
+auto BasicBrent<Traits, F>::solve() -> Real
+{
+	this->beginSolve();
+	// Working bracket, the members stay the interval of the problem
+	Real a{this->a};
+	Real b{this->b};
+	auto ya = fa;
+  auto yb = fb;
+
+  // First check.
+  if(!((ya * yb) < 0.0))
+    {
+      const bool exact = (ya == 0. || yb == 0.);
+      this->setStats(exact ? SolveStatus::Converged : SolveStatus::InvalidInterval, 0u, std::min(std::abs(ya), std::abs(yb)), b - a);
+      if(ya == 0.)
+        return a;
+      else if(yb == 0.)
+        return b;
+      else
+			{
+				Logger::log(LogLevel::Error, "ERROR, could not find the zero");
+				 
+				return std::numeric_limits<Real>::quiet_NaN(); // precondition not met
+			}	 
+    };
+  //
+  if(std::abs(ya) < std::abs(yb))
+    {
+      std::swap(a, b);
+      std::swap(ya, yb);
+    }
+  //
+  auto     c = a;
+  auto     d = c;
+  auto     yc = ya;
+  bool     mflag{true};
+  auto     s = b;
+  auto     ys = yb;
+  unsigned iter{0u};
+  bool     stopped{false};
+  do
+    {
+			++iter;
+      //
+      if(ya != yc and yb != yc)
+        {
+          auto yab = ya - yb;
+          auto yac = ya - yc;
+          auto ycb = yc - yb;
+          // inverse quadratic interpolation
+          s = a * ya * yc / (yab * yac) + b * ya * yc / (yab * ycb) -
+              c * ya * yb / (yac * ycb);
+        }
+      else
+        {
+          // secant
+          s = b - yb * (b - a) / (yb - ya);
+        }
+      //
+      if(((s - 3 * (a + b) / 4) * (s - b) >= 0) or // condition 1
+         (mflag and
+          (std::abs(s - b) >= 0.5 * std::abs(b - c))) or // condition 2
+         (!mflag and
+          (std::abs(s - b) >= 0.5 * std::abs(c - d))) or // condition 3
+         (mflag and (std::abs(b - c) < tol)) or          // condition 4
+         (!mflag and (std::abs(c - d) < tol))            // condition 5
+				 )
+        {
+          mflag = true;
+          s = 0.5 * (a + b); // back to bisection step
+        }
+      else
+        mflag = false;
+      if(this->collect)
+        this->stats.brentSteps.push_back(mflag ? BrentStep::Bisection : BrentStep::Interpolation);
+      //
+      ys = this->evalF(s);
+      d = c;
+      c = b;
+      yc = yb;
+      //
+      if(ya * ys < 0)
+        {
+          b = s;
+          yb = ys;
+        }
+      else
+        {
+          a = s;
+          ya = ys;
+        }
+      //
+      if(std::abs(ya) < std::abs(yb))
+        {
+          std::swap(a, b);
+          std::swap(ya, yb);
+        }
+      this->trace("Brent", mflag ? TraceStep::Bisection : TraceStep::Interpolation, iter, s, ys, std::min(a, b), std::max(a, b));
+      //
+      if(this->usePolicy && ys != 0. && std::abs(b - a) > tol && this->checkPolicy(s, b - a, ys))
+        {
+          stopped = true;
+          break;
+        }
+		}
+  while(ys != 0. && std::abs(b - a) > tol && iter < maxIt);
+	this->setStats(stopped ? this->policyStatus : iter < maxIt ? SolveStatus::Converged : SolveStatus::MaxIterations, iter, std::abs(ys), std::abs(b - a));
+	if (iter < maxIt || stopped)
+		return s;
+	else {
+				Logger::log(LogLevel::Error, "ERROR, could not find the zero");
+				 
+				return std::numeric_limits<Real>::quiet_NaN();
+	}
+}
+
+// Safeguarded Newton implementation
+/*!
+ * Starts from the midpoint of the interval. The Newton step is accepted
+ * if it stays strictly inside [a, b] and |f| / |f'| is at most half of
+ * the step before, else the midpoint is taken. After each evaluation the
+ * extreme with the same sign of f is moved to the new point. Stops when
+ * the step is below tol or |f| below tola
+ *
+ * @return The approximation of the zero of f (NaN if not found)
+ */
+template<class Traits, class F, class DF>
+auto BasicSafeNewton<Traits, F, DF>::solve() -> Real
+{
+	this->beginSolve();
+	// Working bracket, the members stay the interval of the problem
+	Real a{this->a};
+	Real b{this->b};
+	Real ya = fa;
+	Real yb = fb;
+	if (!(ya * yb <= 0))
+	{
+		Logger::log(LogLevel::Error, "ERROR, function must change sign at the two end values");
+		this->setStats(SolveStatus::InvalidInterval, 0u, std::min(std::abs(ya), std::abs(yb)), b - a);
+
+		return std::numeric_limits<Real>::quiet_NaN();
+	}
+	if (ya == 0. || yb == 0.)
+	{
+		this->setStats(SolveStatus::Converged, 0u, 0., b - a);
+		return ya == 0. ? a : b;
+	}
+
+	Real x = (a + b) / 2.;
+	Real y = this->evalF(x);
+	Real dy = evalDF(x);
+	Real dx = std::abs(b - a);
+	Real dxOld = dx;
+	unsigned int iter{0u};
+	bool converged = std::abs(y) <= tola;
+	bool stopped{false};
+	while (!converged && iter < maxIt)
+	{
+		++iter;
+		if (y * ya < 0.0)
+		{
+			b = x;
+			yb = y;
+		}
+		else
+		{
+			a = x;
+			ya = y;
+		}
+
+		const Real xNewton = x - y / dy;
+		dxOld = dx;
+		const bool newtonStep = (xNewton - a) * (xNewton - b) < 0 && std::abs(2 * y) <= std::abs(dxOld * dy);
+		if (newtonStep)
+		{
+			dx = std::abs(xNewton - x);
+			x = xNewton;
+		}
+		else
+		{
+			// Bisection step
+			dx = std::abs(b - a) / 2.;
+			x = (a + b) / 2.;
+		}
+		y = this->evalF(x);
+		this->trace("SafeNewton", newtonStep ? TraceStep::Newton : TraceStep::Bisection, iter, x, y, a, b);
+		converged = dx < tol || std::abs(y) <= tola;
+		if (this->usePolicy && !converged && this->checkPolicy(x, dx, y))
+		{
+			stopped = true;
+			break;
+		}
+		if (!converged)
+			dy = evalDF(x);
+	}
+	this->setStats(converged ? SolveStatus::Converged : stopped ? this->policyStatus : SolveStatus::MaxIterations, iter, std::abs(y), std::abs(b - a));
+
+	if (converged || stopped)
+		return x;
+	else
+	{
+		Logger::log(LogLevel::Error, "ERROR, could not find the zero");
+
+		return std::numeric_limits<Real>::quiet_NaN();
+	}
+}
+
+// Modified Regula Falsi implementation
+/*!
+ * b is the last point of the chord and a the retained extreme, in the
+ * chord the value at a is scaled every time a is retained again.
+ * Stops when the residual is below tol * resid0 + tola, as regula falsi
+ *
+ * @return The approximation of the zero of f (NaN if not found)
+ */
+template<class Traits, class F>
+auto BasicModifiedRegulaFalsi<Traits, F>::solve() -> Real
+{
+	this->beginSolve();
+	// Working bracket, the members stay the interval of the problem
+	Real a{this->a};
+	Real b{this->b};
+	Real ya = fa;
+	Real yb = fb;
+	const Real resid0 = std::max(std::abs(ya), std::abs(yb));
+	if (!(ya * yb <= 0))
+	{
+		Logger::log(LogLevel::Error, "ERROR, function must change sign at the two end values");
+		this->setStats(SolveStatus::InvalidInterval, 0u, std::min(std::abs(ya), std::abs(yb)), b - a);
+
+		return std::numeric_limits<Real>::quiet_NaN();
+	}
+	if (ya == 0.)
+	{
+		this->setStats(SolveStatus::Converged, 0u, 0., b - a);
+		return a;
+	}
+
+	// Value at a used in the chord
+	Real sa{ya};
+	Real c{b};
+	Real yc{yb};
+	unsigned int iter{0u};
+	const Real check = tol * resid0 + tola;
+	constexpr Real small = 10.0 * std::numeric_limits<Real>::epsilon();
+	bool stopped{false};
+	while (std::abs(yc) > check && std::abs(b - a) > small * std::abs(c) && iter < maxIt)
+	{
+		++iter;
+		c = b - yb * (b - a) / (yb - sa);
+		yc = this->evalF(c);
+		if (yc * yb < 0.0)
+		{
+			// b is the new retained extreme
+			a = b;
+			ya = yb;
+			sa = yb;
+		}
+		else
+		{
+			// a is retained again
+			const Real m = 1. - yc / yb;
+			sa *= (scaling == SideScaling::AndersonBjorck && m > 0.) ? m : 0.5;
+		}
+		b = c;
+		yb = yc;
+		this->trace(scaling == SideScaling::AndersonBjorck ? "AndersonBjorck" : "Illinois", TraceStep::Chord, iter, c, yc, std::min(a, b), std::max(a, b));
+		if (this->usePolicy && std::abs(yc) > check && std::abs(b - a) > small * std::abs(c) && this->checkPolicy(c, b - a, yc))
+		{
+			stopped = true;
+			break;
+		}
+	}
+	const bool converged = std::abs(yc) <= check || std::abs(b - a) <= small * std::abs(c);
+	this->setStats(converged ? SolveStatus::Converged : stopped ? this->policyStatus : SolveStatus::MaxIterations, iter, std::abs(yc), std::abs(b - a));
+
+	if (converged || stopped)
+		return c;
+	else
+	{
+		Logger::log(LogLevel::Error, "ERROR, could not find the zero");
+
+		return std::numeric_limits<Real>::quiet_NaN();
+	}
+}
+
+// Newton implemetation
+/*!
+ * Computes the zero of a scalar function with the method of Newton.
+ * Quasi-Newton methods will rely on this implemetation, the only difference will be that the derivative will be approximated with finite differences when creating the object
+ *
+ * @return The approximation of the zero of f (NaN if not found)
+ */
+template<class Traits, class F, class DF>
+auto BasicNewton<Traits, F, DF>::solve() -> Real
+{
+	this->beginSolve();
+	// Iterate, the member stays the starting point
+	Real x0{this->x0};
+	Real y0 = this->evalF(x0);
+	Real resid = std::abs(y0);
+	unsigned int iter{0u};
+	Real check = tol * resid + tola;
+	bool goOn = resid > check;
+	bool stopped{false};
+	while(goOn && iter < maxIt)
+	{
+		++iter;
+		const Real dx = -y0/evalDF(x0);
+		x0 += dx;
+		y0 = this->evalF(x0);
+		this->trace("Newton", TraceStep::Newton, iter, x0, y0);
+		resid = std::abs(y0);
+		goOn = resid > check;
+		if (this->usePolicy && goOn && this->checkPolicy(x0, dx, y0))
+		{
+			stopped = true;
+			break;
+		}
+	}
+	const SolveStatus status = stopped ? this->policyStatus : !std::isfinite(x0) ? SolveStatus::Diverged : iter < maxIt ? SolveStatus::Converged : SolveStatus::MaxIterations;
+	this->setStats(status, iter, resid);
+
+	if (status == SolveStatus::Converged || stopped)
+		return x0;
+	else
+	{
+		Logger::log(LogLevel::Error, "ERROR, could not find the zero");
+ 
+		 return std::numeric_limits<Real>::quiet_NaN();
+	}
+}
+
+// QuasiNewton implementation
+/*!
+ * The Central slope is the Newton iteration with the central difference
+ * (f(x + h) - f(x - h)) / (2 h) at every iteration. The others take the
+ * one-sided difference (f(x + h) - f(x)) / h, which reuses f(x): Forward
+ * at every iteration, Chord every refresh iterations keeping it in
+ * between, Secant only at the first iteration, then the slope through the
+ * last two iterates. A zero or not finite one-sided slope is replaced by
+ * the one-sided difference. All the evaluations are counted in fEvals.
+ * Same stopping criterion of Newton
+ *
+ * @return The approximation of the zero of f (NaN if not found)
+ */
+template<class Traits, class F>
+auto BasicQuasiNewton<Traits, F>::solve() -> Real
+{
+	this->beginSolve();
+	// Iterate, the member stays the starting point
+	Real x0{this->x0};
+	Real y0 = this->evalF(x0);
+	Real resid = std::abs(y0);
+	unsigned int iter{0u};
+	Real check = tol * resid + tola;
+	bool goOn = resid > check;
+	bool stopped{false};
+	Real xOld{x0};
+	Real yOld{y0};
+	Real dy{0.};
+	while(goOn && iter < maxIt)
+	{
+		++iter;
+		const bool difference = (slope == SlopeUpdate::Forward) || (iter == 1) || (slope == SlopeUpdate::Chord && (iter - 1) % refresh == 0);
+		if (slope == SlopeUpdate::Central)
+			dy = (this->evalF(x0 + h) - this->evalF(x0 - h)) / (2 * h);
+		else
+		{
+			if (!difference && slope == SlopeUpdate::Secant)
+				dy = (y0 - yOld) / (x0 - xOld);
+			if (difference || dy == 0. || !std::isfinite(dy))
+				dy = (this->evalF(x0 + h) - y0) / h;
+		}
+		const Real dx = -y0/dy;
+		xOld = x0;
+		yOld = y0;
+		x0 += dx;
+		y0 = this->evalF(x0);
+		this->trace("QuasiNewton", slope == SlopeUpdate::Secant && !difference ? TraceStep::Secant : TraceStep::Newton, iter, x0, y0);
+		resid = std::abs(y0);
+		goOn = resid > check;
+		if (this->usePolicy && goOn && this->checkPolicy(x0, dx, y0))
+		{
+			stopped = true;
+			break;
+		}
+	}
+	const SolveStatus status = stopped ? this->policyStatus : !std::isfinite(x0) ? SolveStatus::Diverged : iter < maxIt ? SolveStatus::Converged : SolveStatus::MaxIterations;
+	this->setStats(status, iter, resid);
+
+	if (status == SolveStatus::Converged || stopped)
+		return x0;
+	else
+	{
+		Logger::log(LogLevel::Error, "ERROR, could not find the zero");
+
+		return std::numeric_limits<Real>::quiet_NaN();
+	}
+}
+
+// Newton with automatic differentiation implementation
+/*!
+ * Same iteration and stopping criterion of Newton, f and df come from one
+ * evaluation on a dual number
+ *
+ * @return The approximation of the zero of f (NaN if not found)
+ */
+template<class Traits, class G, class F>
+auto BasicAutoDiffNewton<Traits, G, F>::solve() -> Real
+{
+	this->beginSolve();
+	// Iterate, the member stays the starting point
+	Real x0{this->x0};
+	Dual<Real> y0 = evalFDF(x0);
+	Real resid = std::abs(y0.v);
+	unsigned int iter{0u};
+	Real check = tol * resid + tola;
+	bool goOn = resid > check;
+	bool stopped{false};
+	while(goOn && iter < maxIt)
+	{
+		++iter;
+		const Real dx = -y0.v/y0.d;
+		x0 += dx;
+		y0 = evalFDF(x0);
+		this->trace("AutoDiffNewton", TraceStep::Newton, iter, x0, y0.v);
+		resid = std::abs(y0.v);
+		goOn = resid > check;
+		if (this->usePolicy && goOn && this->checkPolicy(x0, dx, y0.v))
+		{
+			stopped = true;
+			break;
+		}
+	}
+	const SolveStatus status = stopped ? this->policyStatus : !std::isfinite(x0) ? SolveStatus::Diverged : iter < maxIt ? SolveStatus::Converged : SolveStatus::MaxIterations;
+	this->setStats(status, iter, resid);
+
+	if (status == SolveStatus::Converged || stopped)
+		return x0;
+	else
+	{
+		Logger::log(LogLevel::Error, "ERROR, could not find the zero");
+
+		return std::numeric_limits<Real>::quiet_NaN();
+	}
+}
+
+// Halley implementation
+/*!
+ * Same stopping criterion of Newton, with the step
+ * -2 f f' / (2 f'^2 - f f'')
+ *
+ * @return The approximation of the zero of f (NaN if not found)
+ */
+template<class Traits, class F, class DF, class D2F>
+auto BasicHalley<Traits, F, DF, D2F>::solve() -> Real
+{
+	this->beginSolve();
+	// Iterate, the member stays the starting point
+	Real x0{this->x0};
+	Real y0 = this->evalF(x0);
+	Real resid = std::abs(y0);
+	unsigned int iter{0u};
+	Real check = tol * resid + tola;
+	bool goOn = resid > check;
+	bool stopped{false};
+	while(goOn && iter < maxIt)
+	{
+		++iter;
+		const Real dy = this->evalDF(x0);
+		const Real d2y = evalD2F(x0);
+		const Real dx = -2 * y0 * dy / (2 * dy * dy - y0 * d2y);
+		x0 += dx;
+		y0 = this->evalF(x0);
+		this->trace("Halley", TraceStep::Halley, iter, x0, y0);
+		resid = std::abs(y0);
+		goOn = resid > check;
+		if (this->usePolicy && goOn && this->checkPolicy(x0, dx, y0))
+		{
+			stopped = true;
+			break;
+		}
+	}
+	const SolveStatus status = stopped ? this->policyStatus : !std::isfinite(x0) ? SolveStatus::Diverged : iter < maxIt ? SolveStatus::Converged : SolveStatus::MaxIterations;
+	this->setStats(status, iter, resid);
+
+	if (status == SolveStatus::Converged || stopped)
+		return x0;
+	else
+	{
+		Logger::log(LogLevel::Error, "ERROR, could not find the zero");
+
+		return std::numeric_limits<Real>::quiet_NaN();
+	}
+}
+
+// Steffensen implementation
+/*!
+ * Same stopping criterion of Newton, the derivative is replaced by the
+ * divided difference with step f(x)
+ *
+ * @return The approximation of the zero of f (NaN if not found)
+ */
+template<class Traits, class F>
+auto BasicSteffensen<Traits, F>::solve() -> Real
+{
+	this->beginSolve();
+	// Iterate, the member stays the starting point
+	Real x0{this->x0};
+	Real y0 = this->evalF(x0);
+	Real resid = std::abs(y0);
+	unsigned int iter{0u};
+	Real check = tol * resid + tola;
+	bool goOn = resid > check;
+	bool stopped{false};
+	while(goOn && iter < maxIt)
+	{
+		++iter;
+		const Real slope = (this->evalF(x0 + y0) - y0) / y0;
+		const Real dx = -y0/slope;
+		x0 += dx;
+		y0 = this->evalF(x0);
+		this->trace("Steffensen", TraceStep::Steffensen, iter, x0, y0);
+		resid = std::abs(y0);
+		goOn = resid > check;
+		if (this->usePolicy && goOn && this->checkPolicy(x0, dx, y0))
+		{
+			stopped = true;
+			break;
+		}
+	}
+	const SolveStatus status = stopped ? this->policyStatus : !std::isfinite(x0) ? SolveStatus::Diverged : iter < maxIt ? SolveStatus::Converged : SolveStatus::MaxIterations;
+	this->setStats(status, iter, resid);
+
+	if (status == SolveStatus::Converged || stopped)
+		return x0;
+	else
+	{
+		Logger::log(LogLevel::Error, "ERROR, could not find the zero");
+
+		return std::numeric_limits<Real>::quiet_NaN();
+	}
+}
+
+#endif
@@ -0,0 +1,119 @@
+#include <cmath>
+#include <limits>
+#include "SolverFactory.hpp"
+
+/*
+ * Example of a plugin: a shared library that adds the Ridders method to the
+ * registry of the factory, loaded by ./main plugin=./libexamplePlugin.so
+ * method=Ridders
+ */
+
+namespace
+{
+/* * * * * * * * * *
+ * Ridders method  *
+ * * * * * * * * * */
+/*!
+ * Keeps a bracket and at every iteration evaluates f at the midpoint m and
+ * at the point given by the exponential fit through a, m, b, which lies in
+ * the bracket; it converges quadratically with two evaluations per
+ * iteration
+ */
+class Ridders final : public SolverWithInterval
+{
+public:
+	Ridders(const T::FunType& f_, const Real& a_, const Real& b_, const Real& tol_, const Real& tola_, const unsigned int& maxIt_, const Real& h_interval_, const unsigned int& maxIter_, const BracketStrategy& strategy_) :
+		SolverWithInterval(f_, a_, b_, tol_, h_interval_, maxIter_, strategy_), tola(tola_), maxIt(maxIt_) {}
+
+	Real solve() override
+	{
+		// As the solvers of the library: beginSolve starts the limits of
+		// the stopping policy and the trace, the bracket is a local copy
+		beginSolve();
+		Real a{this->a};
+		Real b{this->b};
+		Real ya{fa};
+		Real yb{fb};
+		if (!(ya * yb <= 0))
+		{
+			Logger::log(LogLevel::Error, "ERROR, function must change sign at the two end values");
+			setStats(SolveStatus::InvalidInterval, 0u, std::min(std::abs(ya), std::abs(yb)), b - a);
+
+			return std::numeric_limits<Real>::quiet_NaN();
+		}
+
+		Real x{ya == 0. ? a : b};
+		Real y{ya == 0. ? ya : yb};
+		unsigned int iter{0u};
+		bool stopped{false};
+		while (std::abs(y) > tola && b - a > 2 * tol && iter < maxIt)
+		{
+			++iter;
+			const Real m = (a + b) / 2;
+			const Real ym = evalF(m);
+			const Real s = std::sqrt(ym * ym - ya * yb);
+			if (s == 0.)
+			{
+				x = m;
+				y = ym;
+				trace("Ridders", TraceStep::Bisection, iter, x, y, a, b);
+				break;
+			}
+			x = m + (m - a) * ((ya > yb) ? ym : -ym) / s;
+			y = evalF(x);
+			// Smallest bracket with extremes among a, m, x, b
+			const bool xFirst = (x < m);
+			if (ym * y < 0)
+			{
+				a = xFirst ? x : m;
+				ya = xFirst ? y : ym;
+				b = xFirst ? m : x;
+				yb = xFirst ? ym : y;
+			}
+			else if (ya * y < 0)
+			{
+				b = xFirst ? x : m;
+				yb = xFirst ? y : ym;
+			}
+			else
+			{
+				a = xFirst ? m : x;
+				ya = xFirst ? ym : y;
+			}
+			trace("Ridders", TraceStep::Interpolation, iter, x, y, a, b);
+			if (usePolicy && std::abs(y) > tola && b - a > 2 * tol && checkPolicy(x, b - a, y))
+			{
+				stopped = true;
+				break;
+			}
+		}
+		const bool converged = (std::abs(y) <= tola || b - a <= 2 * tol);
+		setStats(stopped ? policyStatus : converged ? SolveStatus::Converged : SolveStatus::MaxIterations, iter, std::abs(y), b - a);
+		return (std::abs(y) <= tola) ? x : (a + b) / 2;
+	}
+
+	using SolverWithInterval::solve;
+
+	void reset(const Parameters& p) override
+	{
+		tola = p.tola;
+		maxIt = p.maxIt;
+		SolverWithInterval::reset(p);
+	}
+
+private:
+	// Absolute tolerance
+	Real tola;
+	// Maximum number of iterations
+	unsigned int maxIt;
+};
+}
+
+// Entry point called by SolverFactory::loadPlugin
+extern "C" void registerSolvers(SolverFactory::Registrar registerSolver)
+{
+	registerSolver("Ridders", [](const SolverFunctions& fs, const SolverParameters& p) -> SolverFactory::Solver
+	{
+		return std::make_unique<Ridders>(fs.f, p.a, p.b, p.tol, p.tola, p.maxIt, p.h_interval, p.maxIter, p.strategy);
+	});
+}
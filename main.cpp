@@ -1,94 +1,210 @@
 #include <cmath>
+#include <fstream>
 #include <iostream>
 #include <limits>
 #include <memory>
 #include <ostream>
+#include <thread>
 #include "GetPot"
 #include "classZeroFun.hpp"
 #include "SolverFactory.hpp"
+#include "SolverParameters.hpp"
+#include "BatchMode.hpp"
+#include "CompiledConfig.hpp"
+#include "MixedPrecision.hpp"
 using T = SolverTraits;
 
+// Reads the parameters and the coefficients of the polynomial from a text datafile, returns the error (empty if there is none)
+static std::string readDataFile(const std::string& filename, SolverParameters& p, std::vector<T::Real>& coefficients)
+{
+	GetPot datafile(filename.c_str());
+
+	const	std::string section = "Parameters/";
+
+	p.a = datafile((section + "a").data(), p.a);										// Interval lower extreme
+	p.b = datafile((section + "b").data(), p.b);										// Interval upper extreme
+	p.tol = datafile((section + "tol").data(), p.tol);								// Tolerance
+	p.tola = datafile((section + "tola").data(), p.tola);						// Absolute tolerance
+	p.maxIt = datafile((section + "maxIt").data(), static_cast<int>(p.maxIt));				// Max number of iteration for the methods
+	p.h_interval = datafile((section + "h_interval").data(), p.h_interval);	// Step for the bracket interval function
+	p.maxIter = datafile((section + "maxIter").data(), static_cast<int>(p.maxIter));		// Max number of iteration for bracket interval function
+	p.x0 = datafile((section + "x0").data(), p.x0);									// Starting point for Newton-like methods
+	p.h = datafile((section + "h").data(), p.h);										// Step for derivative approximation in QuasiNewton method
+	p.sections = datafile((section + "sections").data(), static_cast<int>(p.sections));	// Parts of the interval at every iteration of Multisection method
+	p.refresh = datafile((section + "refresh").data(), static_cast<int>(p.refresh));	// Iterations between two differences of the Chord slope of QuasiNewton method
+	const std::string bracket = datafile((section + "bracket").data(), "Linear");	// Strategy for the bracket interval function
+	const std::string slope = datafile((section + "slope").data(), "Central");	// Approximation of the derivative in QuasiNewton method
+
+	// Coefficients of the polynomial, from the lowest degree (needed for Polynomial method)
+	for (unsigned int i = 0; i < datafile.vector_variable_size((section + "coefficients").data()); ++i)
+		coefficients.push_back(datafile((section + "coefficients").data(), 0., i));
+
+	if (bracket == "Golden")
+		p.strategy = BracketStrategy::Golden;
+	else if (bracket == "Extrapolation")
+		p.strategy = BracketStrategy::Extrapolation;
+	else if (bracket != "Linear")
+		return "invalid bracket strategy";
+
+	if (slope == "Forward")
+		p.slope = SlopeUpdate::Forward;
+	else if (slope == "Secant")
+		p.slope = SlopeUpdate::Secant;
+	else if (slope == "Chord")
+		p.slope = SlopeUpdate::Chord;
+	else if (slope != "Central")
+		return "invalid slope update";
+	return "";
+}
+
 int main(int argc, char** argv)
-{	
+{
 	std::cout << "======== Running the solver ========\n" << std::endl;
-	
-	// Function for which we want to calculate the zero
-	auto fun = [](const T::Real& x) {return 0.5 - std::exp(M_PI * x);};
+
+	// Function for which we want to calculate the zero, generic so that it
+	// can also be evaluated on dual numbers (AutoDiffNewton method)
+	auto fun = [](const auto& x) {using std::exp; return 0.5 - exp(M_PI * x);};
 	// Derivative of the function (needed for Newton method)
-	auto dfun = [](const T::Real& x) {return - M_PI * std::exp(M_PI * x);};
+	auto dfun = [](const auto& x) {using std::exp; return - M_PI * exp(M_PI * x);};
+	// Second derivative of the function (needed for Halley method)
+	auto d2fun = [](const auto& x) {using std::exp; return - M_PI * M_PI * exp(M_PI * x);};
+	SolverFunctions functions;
+	functions.f = fun;
+	functions.df = dfun;
+	functions.d2f = d2fun;
+	functions.fd = fun;
+	// Interval extensions (needed for IntervalNewton method)
+	functions.fi = fun;
+	functions.dfi = dfun;
 
-	// Read from command_line the datafile name and the method name	
+	// Read from command_line the datafile name and the method name
 	GetPot command_line(argc, argv);
 
 	const std::string filename = command_line.follow("data.dat", 2, "-f", "--file" ); // file storing the parameters
 	const std::string method = command_line("method", "Bisection");	// method name
+	const std::string batch = command_line("batch", "");	// CSV file with the problems (batch mode)
+	const std::string output = command_line("output", "results.csv");	// CSV file with the results (batch mode)
+	const std::string plugin = command_line("plugin", "");	// shared library with more methods
+	const std::string precision = command_line("precision", "double");	// float, double, long (double), quad (__float128, if the compiler has it) or mixed (float, then double)
+	const unsigned int threads = command_line("threads", static_cast<int>(std::thread::hardware_concurrency()));	// threads (batch mode)
+	const bool resume = command_line("resume", false);	// continue from the checkpoint of the output (binary batch mode)
+	const std::string backend = command_line("backend", "");	// cpu or gpu: kernels of DeviceBatchSolver instead of the solvers (batch mode)
+	const std::string traceFile = command_line("trace", "");	// CSV, or JSON if it ends with .json, file with the iterations (compiled with ZEROFUN_TRACE)
+	const std::string compile = command_line("compile", "");	// file where the parameters are written in compiled form, read faster than datafile
 
-	// Read parameters from datafile
-	GetPot datafile(filename.c_str());
-	
-	const	std::string section = "Parameters/";
-	
-	const T::Real a = datafile((section + "a").data(), -1.0);										// Interval lower extreme
-	const	T::Real b = datafile((section + "b").data(), 1.0);										// Interval upper extreme
-	const T::Real tol = datafile((section + "tol").data(), 1e-4);								// Tolerance
-	const T::Real tola = datafile((section + "tola").data(), 1e-10);						// Absolute tolerance
-	const unsigned int maxIt = datafile((section + "maxIt").data(), 150);				// Max number of iteration for the methods
-	const T::Real h_interval = datafile((section + "h_interval").data(), 0.01);	// Step for the bracket interval function
-	const unsigned int maxIter = datafile((section + "maxIter").data(), 200);		// Max number of iteration for bracket interval function
-	const T::Real x0 = datafile((section + "x0").data(), 0.0);									// Starting point for Newton-like methods
-	const T::Real h = datafile((section + "h").data(), 1e-3);										// Step for derivative approximation in QuasiNewton method
-
-	// Solver declaration
-	SolverFactory solver;
-	std::unique_ptr<SolverBase> solver_ptr = nullptr;
-
-	if (method == "RegulaFalsi")
-	{	
-		// Regula Falsi method
-		solver_ptr = solver.make_solver<RegulaFalsi>(fun, a, b, tol, tola, h_interval, maxIter);
-	}
-	else if (method == "Bisection")
+	// Read parameters from datafile, parsed by GetPot only if it is not compiled
+	SolverParameters p;
+	const CompiledConfig config(filename);
+	if (!config.error().empty())
 	{
-		// Bisection method
-		solver_ptr = solver.make_solver<Bisection>(fun, a, b, tol, h_interval, maxIter);
+		std::cout << "ERROR, " << config.error() << std::endl;
+		return 1;
 	}
-	else if (method == "Secant")
+	if (config.compiled())
 	{
-		// Secant method 
-		solver_ptr = solver.make_solver<Secant>(fun, a, b, tol, tola, maxIt, h_interval, maxIter);
+		p = config.parameters;
+		functions.coefficients = config.coefficients;
 	}
-	else if (method == "Brent")
+	else
 	{
-		// Brent
-		solver_ptr = solver.make_solver<Brent>(fun, a, b, tol, maxIt, h_interval, maxIter);
+		const std::string error = readDataFile(filename, p, functions.coefficients);
+		if (!error.empty())
+		{
+			std::cout << "ERROR, " << error << std::endl;
+			return 1;
+		}
 	}
-	else if (method == "Newton")
-	{
-		// Newton method
-		solver_ptr = solver.make_solver<Newton>(fun, dfun, x0, tol, tola, maxIt);
-	}	
-	else if (method == "QuasiNewton")
+
+	// The parameters compiled for the following launches
+	if (!compile.empty())
 	{
-		// QuasiNewton method
-		solver_ptr = solver.make_solver<QuasiNewton>(fun, x0, h, tol, tola, maxIt);
+		if (!CompiledConfig::write(compile, p, functions.coefficients))
+		{
+			std::cout << "ERROR, cannot write " << compile << std::endl;
+			return 1;
+		}
+		std::cout << "Parameters of " << filename << " compiled in " << compile << std::endl;
+		return 0;
 	}
-	else 
+
+	// Methods of the plugin, also for the batch mode
+	if (!plugin.empty() && !SolverFactory::loadPlugin(plugin))
 	{
-		std::cout << "ERROR, invalid method" << std::endl;
+		std::cout << "ERROR, cannot load the plugin " << plugin << std::endl;
 		return 1;
 	}
-	
-	// Solving for zero	
-	const T::Real zero = solver_ptr -> solve();
-	
-	if (zero != std::numeric_limits<T::Real>::quiet_NaN())
+
+	// Batch mode: the parameters in the datafile are the defaults of the problems
+	if (!batch.empty())
+		return runBatch(method, functions, p, batch, output, threads, resume, backend);
+
+	// Messages of the solvers on the console
+	Logger::setSink(&Logger::consoleSink, LogLevel::Info);
+
+	// The functions in the precision of the traits of the argument
+	auto functionsFor = [&](auto traits)
 	{
-		std::cout << "Zero found with " << method << " method is: " << zero << std::endl;
-	}
-	else
+		using Tr = decltype(traits);
+		BasicSolverFunctions<Tr> fs;
+		fs.f = fun;
+		fs.df = dfun;
+		fs.d2f = d2fun;
+		fs.fd = fun;
+		fs.coefficients.assign(functions.coefficients.begin(), functions.coefficients.end());
+		fs.fi = fun;
+		fs.dfi = dfun;
+		return fs;
+	};
+
+	// Solving for zero
+	auto report = [&method, &traceFile](const auto& solver_ptr)
 	{
-		std::cout << "Zero couldn't be found" << std::endl;
-	}
+		if (!solver_ptr)
+		{
+			std::cout << "ERROR, invalid method, the methods are:";
+			for (const std::string& name : SolverFactory::methods())
+				std::cout << " " << name;
+			std::cout << std::endl;
+			return 1;
+		}
+
+		const auto stats = solver_ptr -> solveWithStats();
+		if (traceEnabled && !traceFile.empty())
+		{
+			using Real = typename std::decay_t<decltype(*solver_ptr)>::Real;
+			std::ofstream out(traceFile);
+			const auto& trace = BasicSolverTrace<Real>::local();
+			const bool json = traceFile.size() >= 5 && traceFile.compare(traceFile.size() - 5, 5, ".json") == 0;
+			json ? trace.writeJson(out) : trace.writeCsv(out);
+		}
+		else if (!traceFile.empty())
+			std::cout << "WARNING, the trace is not compiled in, build with -DZEROFUN_TRACE" << std::endl;
+		if (stats.ok())
+		{
+			std::cout << "Zero found with " << method << " method is: " << stats.zero << std::endl;
+			std::cout << "Evaluations of f: " << stats.fEvals << ", of df: " << stats.dfEvals << ", iterations: " << stats.iterations << ", time: " << stats.wallTime << " s" << std::endl;
+		}
+		else
+		{
+			std::cout << "Zero couldn't be found" << std::endl;
+		}
+		return 0;
+	};
+
+	// Solver declaration
+	if (precision == "double")
+		return report(SolverFactory().make_solver(method, functions, p));
+	else if (precision == "float")
+		return report(BasicSolverFactory<FloatSolverTraits>().make_solver(method, functionsFor(FloatSolverTraits()), convertParameters<FloatSolverTraits>(p)));
+	else if (precision == "long")
+		return report(BasicSolverFactory<LongDoubleSolverTraits>().make_solver(method, functionsFor(LongDoubleSolverTraits()), convertParameters<LongDoubleSolverTraits>(p)));
+#ifdef ZEROFUN_FLOAT128
+	else if (precision == "quad")
+		return report(BasicSolverFactory<Float128SolverTraits>().make_solver(method, functionsFor(Float128SolverTraits()), convertParameters<Float128SolverTraits>(p)));
+#endif
+	else if (precision == "mixed")
+		return report(make_mixed_precision_solver<T>(method, functionsFor(FloatSolverTraits()), functions, p));
 
-	return 0;
+	std::cout << "ERROR, invalid precision" << std::endl;
+	return 1;
 }